@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace fs = std::filesystem;
+
+namespace bench
+{
+/// @brief Results of timing the event scheduler in isolation.
+struct SchedulerBenchResult
+{
+    u64 steps;          // Number of times the scheduler was stepped.
+    u64 eventsFired;    // Number of event callbacks that were invoked.
+    double seconds;     // Wall time spent stepping the scheduler.
+};
+
+/// @brief Time the event scheduler without the rest of the system. Every event type is registered with a callback that reschedules
+///        itself on a fixed period, the same way the APU, timers, and PPU keep their events running, and the scheduler is stepped a
+///        few cycles at a time like the CPU does. DMA-style unschedule/reschedule and elapsed cycle queries are mixed in as well.
+/// @param steps Number of times to step the scheduler.
+/// @return Timing results.
+SchedulerBenchResult RunSchedulerBenchmark(u64 steps);
+
+/// @brief Number of THUMB instructions executed by each iteration of the loop in the THUMB dispatch ROM.
+constexpr u64 THUMB_DISPATCH_INSTRUCTIONS_PER_ITERATION = 34;
+
+/// @brief Address in IWRAM where the THUMB dispatch ROM stores the number of loop iterations it has completed.
+constexpr u32 THUMB_DISPATCH_COUNTER_ADDR = 0x0300'4000;
+
+/// @brief Write a GamePak ROM that copies a loop of THUMB instructions to IWRAM and runs it forever without enabling interrupts. The
+///        loop uses every THUMB instruction format except SWI, so running it is dominated by fetching, decoding, and dispatching
+///        THUMB instructions. The ROM is meant to be run with the BIOS intro skipped.
+/// @param romPath Path to write the ROM to.
+/// @return Whether the ROM was written.
+bool WriteThumbDispatchRom(fs::path const& romPath);
+}  // namespace bench
@@ -0,0 +1,186 @@
+#include <Bench/include/Microbenchmarks.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+#include <GBA/include/System/EventScheduler.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace
+{
+/// @brief Event that reschedules itself on a fixed period every time it fires.
+struct PeriodicEvent
+{
+    /// @brief Scheduler callback.
+    /// @param extraCycles Number of cycles that have passed since the event was supposed to fire.
+    void Fire(int extraCycles)
+    {
+        ++firedCount;
+        scheduler->ScheduleEvent(eventType, period - (extraCycles % period));
+    }
+
+    EventScheduler* scheduler;
+    EventType eventType;
+    int period;
+    u64 firedCount;
+};
+
+// ARM code at the GamePak entry point that copies the THUMB loop below into IWRAM and jumps to it.
+constexpr std::array<u32, 10> THUMB_DISPATCH_ENTRY = {
+    0xE28F'0020,    // add r0, pc, #0x20        r0 = address of THUMB code in ROM
+    0xE3A0'1403,    // mov r1, #0x03000000
+    0xE3A0'2054,    // mov r2, #0x54            Size of THUMB code
+    0xE490'3004,    // ldr r3, [r0], #4         copy:
+    0xE481'3004,    // str r3, [r1], #4
+    0xE252'2004,    // subs r2, r2, #4
+    0x1AFF'FFFB,    // bne copy
+    0xE3A0'0403,    // mov r0, #0x03000000
+    0xE380'0001,    // orr r0, r0, #1
+    0xE12F'FF10,    // bx r0
+};
+
+// THUMB loop copied to the start of IWRAM. r6 counts iterations and r7 points at a scratch area at 0x03004000.
+constexpr std::array<u16, 42> THUMB_DISPATCH_LOOP = {
+    0x27C0,     // mov r7, #0xC0
+    0x013F,     // lsl r7, r7, #4
+    0x3701,     // add r7, #1
+    0x03BF,     // lsl r7, r7, #14           r7 = 0x03004000
+    0x2600,     // mov r6, #0
+    0x2508,     // mov r5, #8
+    0x3601,     // add r6, #1                loop:
+    0x603E,     // str r6, [r7, #0]
+    0x6838,     // ldr r0, [r7, #0]
+    0x00C1,     // lsl r1, r0, #3
+    0x084A,     // lsr r2, r1, #1
+    0x188B,     // add r3, r1, r2
+    0x1FDB,     // sub r3, r3, #7
+    0x4043,     // eor r3, r0
+    0x4013,     // and r3, r2
+    0x430B,     // orr r3, r1
+    0x4343,     // mul r3, r0
+    0x4698,     // mov r8, r3
+    0x4443,     // add r3, r8
+    0x4C0A,     // ldr r4, [pc, #40]         Literal at the end of the loop
+    0x517B,     // str r3, [r7, r5]
+    0x5F7C,     // ldsh r4, [r7, r5]
+    0x80BB,     // strh r3, [r7, #4]
+    0x88BC,     // ldrh r4, [r7, #4]
+    0xB082,     // sub sp, #8
+    0x9301,     // str r3, [sp, #4]
+    0x9C01,     // ldr r4, [sp, #4]
+    0xAC02,     // add r4, sp, #8
+    0xB002,     // add sp, #8
+    0xA401,     // add r4, pc, #4
+    0xB40F,     // push {r0-r3}
+    0xBC0F,     // pop {r0-r3}
+    0xC703,     // stmia r7!, {r0, r1}
+    0x3F08,     // sub r7, #8
+    0x2E00,     // cmp r6, #0
+    0xD001,     // beq skip                  Never taken
+    0xF000,     // bl function
+    0xF801,
+    0xE7DE,     // b loop                    skip:
+    0x4770,     // bx lr                     function:
+    0x5678,     // .word 0x12345678
+    0x1234,
+};
+}
+
+namespace bench
+{
+SchedulerBenchResult RunSchedulerBenchmark(u64 steps)
+{
+    constexpr size_t EVENT_COUNT = static_cast<size_t>(EventType::COUNT);
+    EventScheduler scheduler;
+    std::array<PeriodicEvent, EVENT_COUNT> events;
+
+    for (size_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        EventType eventType = static_cast<EventType>(i);
+        events[i] = {&scheduler, eventType, static_cast<int>(37 + (i * 53)), 0};
+        scheduler.RegisterEvent(eventType, {&PeriodicEvent::Fire, events[i]});
+        scheduler.ScheduleEvent(eventType, events[i].period);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (u64 i = 0; i < steps; ++i)
+    {
+        scheduler.Step(1 + (i & 0x03));
+
+        if ((i & 0x03FF) == 0)
+        {
+            scheduler.UnscheduleEvent(EventType::DmaComplete);
+            scheduler.ScheduleEvent(EventType::DmaComplete, 500);
+            scheduler.ElapsedCycles(EventType::Timer0Overflow);
+        }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    u64 eventsFired = 0;
+
+    for (PeriodicEvent const& event : events)
+    {
+        eventsFired += event.firedCount;
+    }
+
+    return {steps, eventsFired, std::chrono::duration<double>(endTime - startTime).count()};
+}
+
+bool WriteThumbDispatchRom(fs::path const& romPath)
+{
+    constexpr size_t ENTRY_ADDR = 0xC0;
+    std::vector<u8> rom(ENTRY_ADDR, 0);
+
+    auto append = [&rom]<typename T>(T val)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            rom.push_back((val >> (8 * i)) & U8_MAX);
+        }
+    };
+
+    // Branch from the start of the GamePak to the entry point after the header.
+    u32 branch = 0xEA00'0000 | (((ENTRY_ADDR - 8) / 4) & 0x00FF'FFFF);
+
+    for (size_t i = 0; i < sizeof(u32); ++i)
+    {
+        rom[i] = (branch >> (8 * i)) & U8_MAX;
+    }
+
+    // Header bytes that must sum to the same value as the Nintendo logo for the GamePak to be accepted.
+    for (size_t i = 0x04; i < 0x9C; ++i)
+    {
+        rom[i] = 123;
+    }
+
+    rom[0x04] += 31;
+
+    std::string_view title = "THUMB LOOP";
+    std::copy(title.begin(), title.end(), rom.begin() + 0xA0);
+
+    for (u32 instruction : THUMB_DISPATCH_ENTRY)
+    {
+        append(instruction);
+    }
+
+    for (u16 instruction : THUMB_DISPATCH_LOOP)
+    {
+        append(instruction);
+    }
+
+    std::ofstream romFile(romPath, std::ios::binary);
+
+    if (romFile.fail())
+    {
+        return false;
+    }
+
+    romFile.write(reinterpret_cast<char const*>(rom.data()), rom.size());
+    return !romFile.fail();
+}
+}  // namespace bench
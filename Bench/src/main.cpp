@@ -0,0 +1,503 @@
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+#include <Bench/include/Microbenchmarks.hpp>
+#include <GBA/include/CPU/CpuTypes.hpp>
+#include <GBA/include/Debug/GameBoyAdvanceDebugger.hpp>
+#include <GBA/include/GameBoyAdvance.hpp>
+#include <GBA/include/PPU/Compositor.hpp>
+#include <GBA/include/PPU/TileCache.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+static_assert(std::endian::native == std::endian::little, "Host system must be little endian");
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr u64 SCHEDULER_BENCH_STEPS = 100'000'000;
+constexpr u64 CYCLES_PER_FRAME = 280'896;
+
+/// @brief Options parsed from the command line.
+struct BenchOptions
+{
+    fs::path biosPath = "bios/Normatt_gba_bios.bin";
+    fs::path romPath = "";
+    fs::path saveDir = fs::temp_directory_path() / "advancedboy-bench";
+    u64 frames = 600;
+    bool skipBiosIntro = false;
+    bool idleLoopSkipping = true;
+    std::unordered_set<std::string> idleLoopSkippingDisabledGameCodes = {};
+    bool hleBios = false;
+    graphics::PixelFormat pixelFormat = graphics::PixelFormat::BGR555;
+    graphics::FrameSkipMode frameSkipMode = graphics::FrameSkipMode::Off;
+    u8 framesToSkip = 0;
+    bool asyncRendering = false;
+    cpu::CpuBackend cpuBackend = cpu::CpuBackend::Interpreter;
+    bool differential = false;
+    std::string microbenchmark = "";
+};
+
+/// @brief Print command line usage.
+/// @param exe Name of the executable.
+void PrintUsage(char const* exe)
+{
+    std::cerr << "Usage: " << exe << " [--bios PATH] [--rom PATH] [--save-dir PATH] [--frames N] [--skip-bios]"
+              << " [--no-idle-skip] [--no-idle-skip-game CODE] [--hle-bios] [--no-bios]"
+              << " [--xrgb8888] [--frame-skip MODE] [--async-render] [--cpu-backend NAME] [--differential] [--micro NAME]\n"
+              << "  --bios PATH         BIOS image to boot with (default: bios/Normatt_gba_bios.bin)\n"
+              << "  --rom PATH          GamePak ROM to run (default: none, runs the BIOS intro only. The intro ends by jumping to the\n"
+              << "                      empty GamePak slot, which stops the run with an error once it executes an invalid instruction)\n"
+              << "  --save-dir PATH     Directory for backup media written on exit (default: system temp directory)\n"
+              << "  --frames N          Number of frames to emulate (default: 600)\n"
+              << "  --skip-bios         Skip the BIOS intro and start executing from the GamePak\n"
+              << "  --no-idle-skip      Emulate idle loops instead of fast forwarding through them\n"
+              << "  --no-idle-skip-game CODE\n"
+              << "                      Emulate idle loops if the ROM's 4 character header game code is CODE (can be repeated)\n"
+              << "  --hle-bios          Run BIOS functions natively instead of through the BIOS\n"
+              << "  --no-bios           Boot without a BIOS file using the built-in high level BIOS\n"
+              << "  --xrgb8888          Output 32 bit XRGB8888 frames instead of BGR555\n"
+              << "  --frame-skip MODE   Frames to skip after each drawn frame (0-255), auto, or never (default: 0)\n"
+              << "  --async-render      Draw scanlines on a separate render thread\n"
+              << "  --cpu-backend NAME  How the CPU decodes instructions: interpreter, or cached (default: interpreter)\n"
+              << "  --differential      Step a second GBA using the interpreter backend in lockstep, one instruction at a time, and\n"
+              << "                      stop with an error as soon as its registers or cycle count differ from the selected backend\n"
+              << "  --micro NAME        Run a microbenchmark: scheduler, or thumb-dispatch (generates and runs a THUMB loop ROM)\n";
+}
+
+/// @brief Parse command line arguments.
+/// @param argc Number of arguments.
+/// @param argv Argument values.
+/// @param options Options to populate.
+/// @return Whether all arguments were valid.
+bool ParseArgs(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        bool hasValue = (i + 1) < argc;
+
+        if ((arg == "--bios") && hasValue)
+        {
+            options.biosPath = argv[++i];
+        }
+        else if ((arg == "--rom") && hasValue)
+        {
+            options.romPath = argv[++i];
+        }
+        else if ((arg == "--save-dir") && hasValue)
+        {
+            options.saveDir = argv[++i];
+        }
+        else if ((arg == "--frames") && hasValue)
+        {
+            char* end = nullptr;
+            options.frames = std::strtoull(argv[++i], &end, 10);
+
+            if ((end == nullptr) || (*end != '\0') || (options.frames == 0))
+            {
+                return false;
+            }
+        }
+        else if (arg == "--skip-bios")
+        {
+            options.skipBiosIntro = true;
+        }
+        else if (arg == "--no-idle-skip")
+        {
+            options.idleLoopSkipping = false;
+        }
+        else if ((arg == "--no-idle-skip-game") && hasValue)
+        {
+            std::string gameCode = argv[++i];
+
+            if (gameCode.size() != 4)
+            {
+                return false;
+            }
+
+            options.idleLoopSkippingDisabledGameCodes.insert(gameCode);
+        }
+        else if (arg == "--hle-bios")
+        {
+            options.hleBios = true;
+        }
+        else if (arg == "--no-bios")
+        {
+            options.biosPath.clear();
+        }
+        else if (arg == "--xrgb8888")
+        {
+            options.pixelFormat = graphics::PixelFormat::XRGB8888;
+        }
+        else if (arg == "--async-render")
+        {
+            options.asyncRendering = true;
+        }
+        else if ((arg == "--frame-skip") && hasValue)
+        {
+            std::string_view mode = argv[++i];
+
+            if (mode == "auto")
+            {
+                options.frameSkipMode = graphics::FrameSkipMode::Auto;
+            }
+            else if (mode == "never")
+            {
+                options.frameSkipMode = graphics::FrameSkipMode::NeverRender;
+            }
+            else
+            {
+                char* end = nullptr;
+                unsigned long long framesToSkip = std::strtoull(argv[i], &end, 10);
+
+                if ((end == nullptr) || (*end != '\0') || (end == argv[i]) || (framesToSkip > U8_MAX))
+                {
+                    return false;
+                }
+
+                options.frameSkipMode = graphics::FrameSkipMode::Fixed;
+                options.framesToSkip = framesToSkip;
+            }
+        }
+        else if ((arg == "--cpu-backend") && hasValue)
+        {
+            std::string_view backend = argv[++i];
+
+            if (backend == "interpreter")
+            {
+                options.cpuBackend = cpu::CpuBackend::Interpreter;
+            }
+            else if (backend == "cached")
+            {
+                options.cpuBackend = cpu::CpuBackend::CachedDecode;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (arg == "--differential")
+        {
+            options.differential = true;
+        }
+        else if ((arg == "--micro") && hasValue)
+        {
+            options.microbenchmark = argv[++i];
+
+            if ((options.microbenchmark != "scheduler") && (options.microbenchmark != "thumb-dispatch"))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Get the peak resident set size of this process.
+/// @return Peak RSS in KiB.
+long PeakRssKiB()
+{
+    rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+
+    return usage.ru_maxrss;
+}
+
+/// @brief Get the CPU time used by the calling thread.
+/// @return CPU time in seconds.
+double ThreadCpuSeconds()
+{
+    timespec time;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    {
+        return 0.0;
+    }
+
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+/// @brief Hash the most recently completed frame so that output can be compared across builds.
+/// @param gba GBA to get the frame buffer from.
+/// @return 64-bit FNV-1a hash of the raw frame buffer.
+u64 HashFrameBuffer(GameBoyAdvance& gba)
+{
+    size_t bytesPerPixel = (gba.GetPixelFormat() == graphics::PixelFormat::XRGB8888) ? sizeof(u32) : sizeof(u16);
+    size_t frameBufferSize = 240 * 160 * bytesPerPixel;
+    uchar const* frameBuffer = gba.GetRawFrameBuffer();
+    u64 hash = 0xCBF2'9CE4'8422'2325;
+
+    for (size_t i = 0; i < frameBufferSize; ++i)
+    {
+        hash ^= frameBuffer[i];
+        hash *= 0x0000'0100'0000'01B3;
+    }
+
+    return hash;
+}
+
+/// @brief Escape a string for use inside a JSON string literal.
+/// @param str String to escape.
+/// @return Escaped string.
+std::string JsonEscape(std::string const& str)
+{
+    std::string escaped;
+
+    for (char c : str)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            escaped += '\\';
+        }
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+/// @brief Apply the emulation options to a GBA.
+/// @param gba GBA to configure.
+/// @param options Parsed command line options.
+void ConfigureGba(GameBoyAdvance& gba, BenchOptions const& options)
+{
+    gba.SetPixelFormat(options.pixelFormat);
+    gba.SetFrameSkip(options.frameSkipMode, options.framesToSkip);
+    gba.SetAsyncRendering(options.asyncRendering);
+    gba.SetCpuBackend(options.cpuBackend);
+
+    if (options.hleBios)
+    {
+        gba.SetHleBios(true);
+    }
+
+    gba.SetIdleLoopSkippingDisabledGameCodes(options.idleLoopSkippingDisabledGameCodes);
+
+    if (!options.idleLoopSkipping)
+    {
+        gba.SetIdleLoopSkipping(false);
+    }
+}
+
+/// @brief Step two GBAs one instruction at a time until either their CPU state diverges or enough cycles for the requested number
+///        of frames have been emulated.
+/// @param gba GBA using the backend under test.
+/// @param reference GBA using the interpreter backend.
+/// @param frames Number of frames worth of cycles to emulate.
+/// @return Number of instructions both GBAs executed before stopping, and whether they stayed in sync.
+std::pair<u64, bool> RunDifferential(GameBoyAdvance& gba, GameBoyAdvance& reference, u64 frames)
+{
+    u64 endCycles = gba.GetTotalElapsedCycles() + (frames * CYCLES_PER_FRAME);
+    u64 instructions = 0;
+
+    while (gba.GetTotalElapsedCycles() < endCycles)
+    {
+        gba.StepCPU();
+        reference.StepCPU();
+        ++instructions;
+
+        if ((gba.GetRegisterSnapshot() != reference.GetRegisterSnapshot()) ||
+            (gba.GetTotalElapsedCycles() != reference.GetTotalElapsedCycles()))
+        {
+            u32 addr = debug::GameBoyAdvanceDebugger(reference).GetCpuDebugInfo().nextAddrToExecute;
+            std::cerr << "Backends diverged after " << instructions << " instructions, next reference instruction at 0x"
+                      << std::hex << std::setw(8) << std::setfill('0') << addr << std::dec << "\n";
+            return {instructions, false};
+        }
+    }
+
+    return {instructions, true};
+}
+
+/// @brief Time the event scheduler on its own and print the results.
+void RunSchedulerMicrobenchmark()
+{
+    bench::SchedulerBenchResult result = bench::RunSchedulerBenchmark(SCHEDULER_BENCH_STEPS);
+
+    std::cout << "{\n"
+              << "  \"microbenchmark\": \"scheduler\",\n"
+              << "  \"steps\": " << result.steps << ",\n"
+              << "  \"events_fired\": " << result.eventsFired << ",\n"
+              << "  \"seconds\": " << result.seconds << ",\n"
+              << "  \"ns_per_step\": " << ((result.seconds * 1e9) / result.steps) << ",\n"
+              << "  \"ns_per_event\": " << ((result.seconds * 1e9) / result.eventsFired) << "\n"
+              << "}" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (options.microbenchmark == "scheduler")
+    {
+        RunSchedulerMicrobenchmark();
+        return EXIT_SUCCESS;
+    }
+
+    fs::create_directories(options.saveDir);
+    bool thumbDispatch = options.microbenchmark == "thumb-dispatch";
+
+    if (thumbDispatch)
+    {
+        // Only the CPU should be doing any work, so nothing is drawn and the loop is never fast forwarded through.
+        options.romPath = options.saveDir / "thumb-dispatch.gba";
+        options.skipBiosIntro = true;
+        options.idleLoopSkipping = false;
+        options.frameSkipMode = graphics::FrameSkipMode::NeverRender;
+
+        if (!bench::WriteThumbDispatchRom(options.romPath))
+        {
+            std::cerr << "Failed to write ROM: " << options.romPath << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    GameBoyAdvance gba(options.biosPath, options.romPath, options.saveDir, [](){}, [](){}, options.skipBiosIntro);
+
+    if (!gba.ValidBiosLoaded())
+    {
+        std::cerr << "Failed to load BIOS: " << options.biosPath << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (!options.romPath.empty() && !gba.ValidGamePakLoaded())
+    {
+        std::cerr << "Failed to load ROM: " << options.romPath << "\n";
+        return EXIT_FAILURE;
+    }
+
+    ConfigureGba(gba, options);
+
+    // The reference GBA saves its backup media to its own directory so the two don't overwrite each other's save files on exit.
+    std::unique_ptr<GameBoyAdvance> reference;
+    u64 differentialInstructions = 0;
+
+    if (options.differential)
+    {
+        fs::path referenceSaveDir = options.saveDir / "reference";
+        fs::create_directories(referenceSaveDir);
+        reference = std::make_unique<GameBoyAdvance>(
+            options.biosPath, options.romPath, referenceSaveDir, [](){}, [](){}, options.skipBiosIntro);
+        ConfigureGba(*reference, options);
+        reference->SetCpuBackend(cpu::CpuBackend::Interpreter);
+    }
+
+    // Audio is generated as normal but discarded after every frame so the internal buffer never fills up.
+    std::vector<float> audioSink;
+    u64 startCycles = gba.GetTotalElapsedCycles();
+    auto startTime = std::chrono::steady_clock::now();
+    double startCpuSeconds = ThreadCpuSeconds();
+
+    u64 frame = 0;
+
+    try
+    {
+        if (reference)
+        {
+            auto [instructions, inSync] = RunDifferential(gba, *reference, options.frames);
+            differentialInstructions = instructions;
+
+            if (!inSync)
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            for (; frame < options.frames; ++frame)
+            {
+                gba.StepFrame();
+                size_t availableSamples = gba.AvailableSamples();
+
+                if (availableSamples > audioSink.size())
+                {
+                    audioSink.resize(availableSamples);
+                }
+
+                gba.DrainAudioBuffer(audioSink.data(), availableSamples);
+            }
+        }
+    }
+    catch (std::exception const& error)
+    {
+        std::cerr << "Emulation stopped at frame " << frame << ": " << error.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    double mainThreadCpuSeconds = ThreadCpuSeconds() - startCpuSeconds;
+    auto endTime = std::chrono::steady_clock::now();
+    u64 emulatedCycles = gba.GetTotalElapsedCycles() - startCycles;
+    double seconds = std::chrono::duration<double>(endTime - startTime).count();
+    graphics::TileCacheStats tileCacheStats = gba.GetTileCacheStats();
+
+    std::cout << "{\n"
+              << "  \"rom\": \"" << JsonEscape(options.romPath.string()) << "\",\n"
+              << "  \"title\": \"" << JsonEscape(gba.GetTitle()) << "\",\n"
+              << "  \"frames\": " << options.frames << ",\n"
+              << "  \"seconds\": " << seconds << ",\n"
+              << "  \"fps\": " << (options.frames / seconds) << ",\n"
+              << "  \"emulated_cycles\": " << emulatedCycles << ",\n"
+              << "  \"cycles_per_second\": " << (emulatedCycles / seconds) << ",\n"
+              << "  \"pixel_format\": \"" << ((options.pixelFormat == graphics::PixelFormat::XRGB8888) ? "xrgb8888" : "bgr555") << "\",\n"
+              << "  \"render_thread\": " << (options.asyncRendering ? "true" : "false") << ",\n"
+              << "  \"main_thread_ms_per_frame\": " << ((mainThreadCpuSeconds * 1000) / options.frames) << ",\n"
+              << "  \"compositor\": \"" << graphics::SelectedCompositorName() << "\",\n"
+              << "  \"cpu_backend\": \"" << ((options.cpuBackend == cpu::CpuBackend::CachedDecode) ? "cached" : "interpreter") << "\",\n"
+              << "  \"idle_cycles_skipped\": " << gba.GetIdleCyclesSkipped() << ",\n"
+              << "  \"tile_cache_hits\": " << tileCacheStats.hits << ",\n"
+              << "  \"tile_cache_misses\": " << tileCacheStats.misses << ",\n"
+              << "  \"peak_rss_kib\": " << PeakRssKiB() << ",\n";
+
+    if (thumbDispatch)
+    {
+        debug::GameBoyAdvanceDebugger debugger(gba);
+        debug::DebugMemAccess iwram = debugger.GetDebugMemAccess(bench::THUMB_DISPATCH_COUNTER_ADDR);
+        u32 iterations;
+        std::memcpy(&iterations, &iwram.memoryBlock[iwram.AddrToIndex(bench::THUMB_DISPATCH_COUNTER_ADDR)], sizeof(u32));
+        u64 thumbInstructions = iterations * bench::THUMB_DISPATCH_INSTRUCTIONS_PER_ITERATION;
+
+        std::cout << "  \"thumb_instructions\": " << thumbInstructions << ",\n"
+                  << "  \"ns_per_thumb_instruction\": " << ((seconds * 1e9) / thumbInstructions) << ",\n";
+    }
+
+    if (reference)
+    {
+        std::cout << "  \"differential_instructions\": " << differentialInstructions << ",\n"
+                  << "  \"reference_frame_hash\": \"" << std::hex << std::setw(16) << std::setfill('0') << HashFrameBuffer(*reference)
+                  << std::dec << "\",\n";
+    }
+
+    std::cout << "  \"frame_hash\": \"" << std::hex << std::setw(16) << std::setfill('0') << HashFrameBuffer(gba) << "\"\n"
+              << "}" << std::endl;
+
+    return EXIT_SUCCESS;
+}
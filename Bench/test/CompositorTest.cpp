@@ -0,0 +1,119 @@
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <GBA/include/PPU/Compositor.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace
+{
+// Longest run composited at once. Runs get shorter as the coefficients change so that every tail length of the SIMD loops is used.
+constexpr size_t MAX_DOTS = 256;
+
+/// @brief Composite function under test and the name to report it by.
+struct CompositeImplementation
+{
+    char const* name;
+    graphics::CompositeFunction composite;
+};
+
+/// @brief Get the SIMD composite functions that are safe to call on this host.
+/// @return Composite functions to compare against CompositeScalar. Unsupported entries are left null.
+std::array<CompositeImplementation, 2> GetSimdImplementations()
+{
+    std::array<CompositeImplementation, 2> implementations = {{{"sse2", nullptr}, {"avx2", nullptr}}};
+    graphics::CompositeFunction selected = graphics::SelectCompositeFunction();
+
+    // SelectCompositeFunction only picks AVX2 on hosts that also support SSE2.
+    if ((selected == graphics::CompositeSse2) || (selected == graphics::CompositeAvx2))
+    {
+        implementations[0].composite = graphics::CompositeSse2;
+    }
+
+    if (selected == graphics::CompositeAvx2)
+    {
+        implementations[1].composite = graphics::CompositeAvx2;
+    }
+
+    return implementations;
+}
+}
+
+/// @brief Check that every SIMD composite function supported by the host produces exactly the same output as CompositeScalar for
+///        every special effect and every combination of EVA, EVB, and EVY in [0, 16].
+/// @return 0 if every output matched, 1 otherwise.
+int main()
+{
+    std::mt19937 rng(0x4144'5642);
+    std::uniform_int_distribution<u16> colorDist(0, 0x7FFF);
+    std::uniform_int_distribution<u16> effectDist(0, 3);
+
+    std::array<u16, MAX_DOTS> topColors;
+    std::array<u16, MAX_DOTS> bottomColors;
+    std::array<graphics::SpecialEffect, MAX_DOTS> effects;
+    std::array<u16, MAX_DOTS> expected;
+    std::array<u16, MAX_DOTS> actual;
+
+    auto implementations = GetSimdImplementations();
+    u64 dotsChecked = 0;
+    u64 mismatches = 0;
+
+    for (u16 eva = 0; eva <= 16; ++eva)
+    {
+        for (u16 evb = 0; evb <= 16; ++evb)
+        {
+            for (u16 evy = 0; evy <= 16; ++evy)
+            {
+                graphics::BlendCoefficients coefficients = {eva, evb, evy};
+                size_t count = MAX_DOTS - (((eva * 17 * 17) + (evb * 17) + evy) % 32);
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    topColors[i] = colorDist(rng);
+                    bottomColors[i] = colorDist(rng);
+                    effects[i] = static_cast<graphics::SpecialEffect>(effectDist(rng));
+                }
+
+                graphics::CompositeScalar(topColors.data(), bottomColors.data(), effects.data(), coefficients, expected.data(), count);
+
+                for (auto const& [name, composite] : implementations)
+                {
+                    if (composite == nullptr)
+                    {
+                        continue;
+                    }
+
+                    actual.fill(0);
+                    composite(topColors.data(), bottomColors.data(), effects.data(), coefficients, actual.data(), count);
+                    dotsChecked += count;
+
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        if (actual[i] == expected[i])
+                        {
+                            continue;
+                        }
+
+                        if (mismatches < 10)
+                        {
+                            std::cerr << name << " mismatch: eva=" << eva << " evb=" << evb << " evy=" << evy
+                                      << " effect=" << static_cast<int>(effects[i]) << " top=" << topColors[i]
+                                      << " bottom=" << bottomColors[i] << " expected=" << expected[i] << " actual=" << actual[i]
+                                      << "\n";
+                        }
+
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto const& [name, composite] : implementations)
+    {
+        std::cout << name << ": " << ((composite == nullptr) ? "not supported on this host, skipped" : "checked") << "\n";
+    }
+
+    std::cout << dotsChecked << " dots checked, " << mismatches << " mismatches\n";
+    return (mismatches == 0) ? 0 : 1;
+}
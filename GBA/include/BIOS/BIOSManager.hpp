@@ -25,7 +25,7 @@ public:
     BIOSManager& operator=(BIOSManager&&) = delete;
 
     /// @brief Initialize the BIOS manager.
-    /// @param biosPath Path to BIOS ROM.
+    /// @param biosPath Path to BIOS ROM. If empty, a minimal built-in BIOS is used that relies on BIOS functions running natively.
     /// @param getPC Callback function to read the current PC value that code is executing from.
     explicit BIOSManager(fs::path biosPath, GetPCCallback getPC);
 
@@ -42,6 +42,11 @@ public:
     /// @return True if BIOS is loaded.
     bool BiosLoaded() const { return biosLoaded_; }
 
+    /// @brief Check if the built-in BIOS is being used in place of a BIOS ROM file. It only contains exception vectors and the IRQ
+    ///        handler, so it can't run the boot intro and only supports BIOS functions that have a native implementation.
+    /// @return True if using the built-in BIOS.
+    bool UsingBuiltInBios() const { return builtInBios_; }
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Save States
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -55,10 +60,14 @@ public:
     void Deserialize(std::ifstream& saveState);
 
 private:
+    /// @brief Fill BIOS memory with the built-in BIOS.
+    void LoadBuiltInBios();
+
     GetPCCallback GetPC;
     std::array<std::byte, 16 * KiB> biosROM_;
     u32 lastSuccessfulFetch_;
     bool biosLoaded_;
+    bool builtInBios_;
 
     // Debug
     friend class debug::GameBoyAdvanceDebugger;
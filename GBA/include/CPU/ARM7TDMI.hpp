@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <fstream>
 #include <functional>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 #include <GBA/include/CPU/CpuTypes.hpp>
 #include <GBA/include/CPU/Registers.hpp>
 #include <GBA/include/System/EventScheduler.hpp>
@@ -19,7 +22,12 @@ namespace cpu
 class ARM7TDMI
 {
     using ReadMemCallback = MemberFunctor<std::pair<u32, int> (GameBoyAdvance::*)(u32, AccessSize)>;
-    using WriteMemCallback = MemberFunctor<int (GameBoyAdvance::*)(u32, u32, AccessSize)>;
+    using SizedReadMemCallback = MemberFunctor<std::pair<u32, int> (GameBoyAdvance::*)(u32)>;
+    using SizedWriteMemCallback = MemberFunctor<int (GameBoyAdvance::*)(u32, u32)>;
+    using BackwardBranchCallback = MemberFunctor<void (GameBoyAdvance::*)()>;
+    using ProtectCodeCallback = MemberFunctor<bool (GameBoyAdvance::*)(u32)>;
+    using ArmHandler = void (ARM7TDMI::*)(u32);
+    using ThumbHandler = void (ARM7TDMI::*)(u16);
 
 public:
     ARM7TDMI() = delete;
@@ -28,13 +36,29 @@ public:
     ARM7TDMI(ARM7TDMI&&) = delete;
     ARM7TDMI& operator=(ARM7TDMI&&) = delete;
 
+    /// @brief Bus read and write callbacks with one entry per access size, so that data accesses never pass the size at runtime.
+    struct BusCallbacks
+    {
+        SizedReadMemCallback ReadByte;
+        SizedReadMemCallback ReadHalfword;
+        SizedReadMemCallback ReadWord;
+        SizedWriteMemCallback WriteByte;
+        SizedWriteMemCallback WriteHalfword;
+        SizedWriteMemCallback WriteWord;
+    };
+
     /// @brief Initialize an ARM7TDMI CPU.
-    /// @param readMem Callback function to access bus read functionality.
-    /// @param writeMem Callback function to access bus write functionality.
+    /// @param bus Callback functions to access bus read and write functionality.
+    /// @param fetchMem Callback function to fetch instructions from the bus.
+    /// @param backwardBranch Callback function to notify the bus of a short backward branch that may be closing an idle loop.
+    /// @param protectCode Callback function to check whether code at an address can have its decoded instructions cached, and if
+    ///        so, to make sure writes to it are reported through InvalidateDecodedCode.
     /// @param scheduler Reference to event scheduler that will be advanced as instructions execute.
     /// @param skipBiosIntro Whether to skip BIOS intro animation and skip straight to executing from cartridge.
-    explicit ARM7TDMI(ReadMemCallback readMem,
-                      WriteMemCallback writeMem,
+    explicit ARM7TDMI(BusCallbacks bus,
+                      ReadMemCallback fetchMem,
+                      BackwardBranchCallback backwardBranch,
+                      ProtectCodeCallback protectCode,
                       EventScheduler& scheduler,
                       bool skipBiosIntro);
 
@@ -56,6 +80,40 @@ public:
     /// @return Address of next instruction to execute.
     u32 GetNextAddrToExecute() const;
 
+    /// @brief Get the value of every register, including banked registers, to compare against the state at another point in time.
+    /// @return Snapshot of all registers.
+    Registers::Snapshot GetRegisterSnapshot() const { return registers_.GetSnapshot(); }
+
+    ///-----------------------------------------------------------------------------------------------------------------------------
+    /// Decoded block cache
+    ///-----------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief Select how instructions are decoded. Switching backends discards any cached blocks.
+    /// @param backend CPU backend to use.
+    void SetBackend(CpuBackend backend);
+
+    /// @brief Discard every cached block. Must be called whenever memory that cached code was decoded from changes without going
+    ///        through InvalidateDecodedCode, such as when loading a save state.
+    void ClearDecodedBlocks();
+
+    /// @brief Discard cached blocks that contain code near a written address. Writes to memory that ProtectCode accepted must be
+    ///        reported here.
+    /// @param addr Address that was written to, with any mirroring removed.
+    void InvalidateDecodedCode(u32 addr);
+
+    ///-----------------------------------------------------------------------------------------------------------------------------
+    /// High level BIOS
+    ///-----------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief Set whether BIOS functions that have a native implementation run natively instead of through the BIOS.
+    /// @param enabled Whether to use native BIOS functions.
+    void SetHleBios(bool enabled) { hleBios_ = enabled; }
+
+    /// @brief Set whether the loaded BIOS is the built-in BIOS. It has no code for BIOS functions, so calling one that has no native
+    ///        implementation throws instead of entering the BIOS.
+    /// @param builtInBios Whether the built-in BIOS is loaded.
+    void SetBuiltInBios(bool builtInBios) { builtInBios_ = builtInBios; }
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Save States
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -85,6 +143,46 @@ private:
     /// @param instruction Undecoded 32-bit ARM instruction.
     void DecodeAndExecuteARM(u32 instruction);
 
+    /// @brief Look up an ARM instruction in the decode table.
+    /// @param instruction Undecoded 32-bit ARM instruction.
+    /// @return Handler from the decode table, which is DecodeAndExecuteARMByFormat if bits 27-20 and 7-4 aren't enough to decode it.
+    static ArmHandler LookupArmHandler(u32 instruction);
+
+    /// @brief Fully decode an ARM instruction, including instructions whose decode table entry is DecodeAndExecuteARMByFormat.
+    /// @param instruction Undecoded 32-bit ARM instruction.
+    /// @return Handler that executes the instruction, not including its condition check.
+    static ArmHandler DecodeArm(u32 instruction);
+
+    /// @brief Decode an ARM instruction by testing it against each instruction format in priority order, then execute it. Used for
+    ///        decode table entries whose format can't be determined from bits 27-20 and 7-4 alone.
+    /// @param instruction Undecoded 32-bit ARM instruction.
+    void DecodeAndExecuteARMByFormat(u32 instruction);
+
+    /// @brief Decode an ARM instruction by testing it against each instruction format in priority order.
+    /// @param instruction Undecoded 32-bit ARM instruction.
+    /// @return Handler that executes the instruction.
+    static ArmHandler DecodeArmByFormat(u32 instruction);
+
+    /// @brief Handler for ARM instructions that don't match any instruction format.
+    /// @param instruction Undecodable 32-bit ARM instruction.
+    [[noreturn]] void ExecuteUndecodableArm(u32 instruction);
+
+    /// @brief Build the ARM decode table, indexed by instruction bits 27-20 and 7-4.
+    /// @return Handler to execute for each decode table index.
+    static constexpr std::array<ArmHandler, 4096> GenerateArmDecodeTable();
+
+    /// @brief Build the table of data processing handlers, indexed by DataProcessingIndex.
+    /// @return Data processing handler specialized for each combination of operand type, opcode, S bit, and shift.
+    static constexpr std::array<ArmHandler, 512> GenerateDataProcessingTable();
+
+    /// @brief Get the index of the data processing handler that can execute an instruction.
+    /// @param instruction Data processing instruction.
+    /// @return Index into table built by GenerateDataProcessingTable.
+    static constexpr u32 DataProcessingIndex(u32 instruction)
+    {
+        return ((instruction & 0x03F0'0000) >> 17) | ((instruction & 0x0000'0070) >> 4);
+    }
+
     void ExecuteBranchAndExchange(u32 instruction);
     void ExecuteBlockDataTransfer(u32 instruction);
     void ExecuteBranch(u32 instruction);
@@ -97,6 +195,11 @@ private:
     void ExecuteHalfwordDataTransfer(u32 instruction);
     void ExecutePSRTransferMRS(u32 instruction);
     void ExecutePSRTransferMSR(u32 instruction);
+
+    /// @brief Execute a data processing instruction. Specialized on the opcode, S bit, whether operand 2 is an immediate, and
+    ///        for register operands, the shift type and whether the shift amount comes from a register.
+    /// @param instruction Undecoded 32-bit data processing instruction.
+    template <u8 OpCode, bool SetFlags, bool ImmOperand, u8 ShiftType, bool RegShift>
     void ExecuteDataProcessing(u32 instruction);
 
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -107,6 +210,19 @@ private:
     /// @param instruction Undecoded 16-bit THUMB instruction.
     void DecodeAndExecuteTHUMB(u16 instruction);
 
+    /// @brief Decode a THUMB instruction.
+    /// @param instruction Undecoded 16-bit THUMB instruction.
+    /// @return Handler that executes the instruction.
+    static ThumbHandler DecodeThumb(u16 instruction);
+
+    /// @brief Build the THUMB decode table, indexed by the top 10 bits of an instruction.
+    /// @return Handler to execute for each decode table index.
+    static constexpr std::array<ThumbHandler, 1024> GenerateThumbDecodeTable();
+
+    /// @brief Handler for THUMB decode table entries that don't match any instruction format.
+    /// @param instruction Undecodable 16-bit THUMB instruction.
+    [[noreturn]] void ExecuteUndecodableThumb(u16 instruction);
+
     void ExecuteThumbSoftwareInterrupt(u16 instruction);
     void ExecuteUnconditionalBranch(u16 instruction);
     void ExecuteConditionalBranch(u16 instruction);
@@ -126,12 +242,149 @@ private:
     void ExecuteAddSubtract(u16 instruction);
     void ExecuteMoveShiftedRegister(u16 instruction);
 
+    ///-----------------------------------------------------------------------------------------------------------------------------
+    /// Decoded block cache
+    ///-----------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief Execute an instruction using the handler cached for its address, decoding and caching it first if needed.
+    /// @param instruction Undecoded instruction from the pipeline.
+    /// @param executedPC Address the instruction was fetched from.
+    /// @param armState Whether the instruction is an ARM instruction.
+    void ExecuteCached(u32 instruction, u32 executedPC, bool armState);
+
+    /// @brief Find the block to cache an instruction in and make room for it, starting a new block if the instruction doesn't
+    ///        directly follow the last one executed.
+    /// @param executedPC Address of the instruction.
+    /// @param armState Whether the instruction is an ARM instruction.
+    /// @return Whether the instruction is already cached or can now be appended to currentBlock_.
+    bool SelectDecodedBlock(u32 executedPC, bool armState);
+
+    /// @brief Record that a block contains code in a chunk, so that writes to that chunk delete the block.
+    /// @param chunk Index of the code chunk.
+    /// @param key Key of the block in decodedBlocks_.
+    void TrackDecodedBlock(u32 chunk, u32 key);
+
+    /// @brief Decoded instruction and the handler that executes it.
+    struct DecodedInstruction
+    {
+        ArmHandler Arm;
+        ThumbHandler Thumb;
+        u32 Opcode;
+    };
+
+    /// @brief Straight line run of decoded instructions, starting at the address the block is keyed by.
+    struct DecodedBlock
+    {
+        std::vector<DecodedInstruction> Instructions;
+        u32 LastChunk;  // Index of the code chunk containing the last cached instruction.
+        bool Complete;  // Whether the block ended at memory that can't be cached, so no more instructions can be added to it.
+    };
+
+    ///-----------------------------------------------------------------------------------------------------------------------------
+    /// High level BIOS functions
+    ///-----------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief Run a BIOS function natively instead of entering the BIOS through the SWI exception vector.
+    /// @param function BIOS function number from the SWI instruction.
+    /// @param swiAddr Address of the SWI instruction. Functions that wait for an interrupt branch back to it to check again.
+    /// @return Whether the function has a native implementation. If not, the SWI exception must be taken as normal.
+    bool ExecuteHleBiosFunction(u8 function, u32 swiAddr);
+
+    void HleSoftReset();
+    void HleRegisterRamReset();
+    void HleIntrWait(bool discardOldFlags, u16 flags, u32 swiAddr);
+    void HleDiv(i32 numerator, i32 denominator);
+    void HleSqrt();
+    void HleArcTan();
+    void HleArcTan2();
+    void HleCpuSet();
+    void HleCpuFastSet();
+    void HleBgAffineSet();
+    void HleObjAffineSet();
+    void HleBitUnPack();
+    void HleLZ77UnComp(bool vram);
+    void HleHuffUnComp();
+    void HleRLUnComp(bool vram);
+
+    /// @brief Where a decompression function writes its output, and how much it has produced so far.
+    struct DecompressedOutput
+    {
+        u32 Dest;           // Address to write the first decompressed byte to.
+        u32 BytesProduced;  // Number of bytes decompressed so far, including a byte waiting to be written as part of a halfword.
+        u8 PendingByte;     // Lower byte of the next halfword to write when writing 16 bits at a time.
+        bool Vram;          // Whether the destination only supports halfword writes.
+    };
+
+    /// @brief Write a decompressed byte to memory as soon as the BIOS would, a byte at a time, or a halfword at a time when the
+    ///        destination only supports halfword writes. Output goes straight to memory so that later reads of the destination,
+    ///        including reads of compressed data that the output overlaps, see it.
+    /// @param output Output destination and progress.
+    /// @param val Decompressed byte.
+    void HleWriteDecompressed(DecompressedOutput& output, u8 val);
+
+    /// @brief Read from the bus on behalf of a BIOS function and advance the scheduler. The scheduler is advanced after every
+    ///        access, so events such as HBlank or a DMA it triggers can fire partway through a BIOS function, the same as they
+    ///        would while the real BIOS code runs. IRQs are still only taken once the function returns.
+    /// @param addr Address to read from.
+    /// @return Value returned from the read.
+    template <AccessSize Length>
+    u32 HleRead(u32 addr);
+
+    /// @brief Write to the bus on behalf of a BIOS function and advance the scheduler. Events can fire partway through a BIOS
+    ///        function, see HleRead.
+    /// @param addr Address to write to.
+    /// @param val Value to write.
+    template <AccessSize Length>
+    void HleWrite(u32 addr, u32 val);
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Bus access
     ///-----------------------------------------------------------------------------------------------------------------------------
 
-    ReadMemCallback ReadMemory;
-    WriteMemCallback WriteMemory;
+    /// @brief Read from the bus.
+    /// @param addr Address to read from.
+    /// @return Value returned from the read and number of cycles taken to read.
+    template <AccessSize Length>
+    std::pair<u32, int> ReadMemory(u32 addr)
+    {
+        if constexpr (Length == AccessSize::BYTE)
+        {
+            return bus_.ReadByte(addr);
+        }
+        else if constexpr (Length == AccessSize::HALFWORD)
+        {
+            return bus_.ReadHalfword(addr);
+        }
+        else
+        {
+            return bus_.ReadWord(addr);
+        }
+    }
+
+    /// @brief Write to the bus.
+    /// @param addr Address to write to.
+    /// @param val Value to write.
+    /// @return Number of cycles taken to write.
+    template <AccessSize Length>
+    int WriteMemory(u32 addr, u32 val)
+    {
+        if constexpr (Length == AccessSize::BYTE)
+        {
+            return bus_.WriteByte(addr, val);
+        }
+        else if constexpr (Length == AccessSize::HALFWORD)
+        {
+            return bus_.WriteHalfword(addr, val);
+        }
+        else
+        {
+            return bus_.WriteWord(addr, val);
+        }
+    }
+
+    BusCallbacks bus_;
+    ReadMemCallback FetchMemory;
+    BackwardBranchCallback BackwardBranch;
 
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// CPU state
@@ -144,6 +397,27 @@ private:
     CircularBuffer<PrefetchedInstruction, 3> pipeline_;
     bool flushPipeline_;
 
+    // Branches back to at most this many instructions behind the branch are reported as possible idle loops.
+    static constexpr u32 MAX_IDLE_LOOP_INSTRUCTIONS = 8;
+
+    // Decoded block cache. Blocks are keyed by their start address, with bit 0 set for THUMB code. Writes are tracked per chunk of
+    // code so that writing data near cached code only invalidates the blocks in that chunk.
+    static constexpr u32 CODE_CHUNK_SHIFT = 8;
+    CpuBackend backend_;
+    ProtectCodeCallback ProtectCode;
+    std::unordered_map<u32, DecodedBlock> decodedBlocks_;
+    std::unordered_map<u32, std::vector<u32>> decodedBlocksByChunk_;
+    DecodedBlock* currentBlock_;
+    u32 currentBlockNextPC_;
+    bool currentBlockArm_;
+    size_t currentBlockIndex_;
+    size_t uncachedInstructions_;
+
+    // High level BIOS
+    bool hleBios_;
+    bool hleIntrWaitRetry_;
+    bool builtInBios_;
+
     // External components
     EventScheduler& scheduler_;
 
@@ -44,4 +44,11 @@ enum class OperatingState : u32
     ARM     = 0,
     THUMB   = 1
 };
+
+/// @brief How the CPU finds the handler for each instruction it executes.
+enum class CpuBackend
+{
+    Interpreter,    // Decode every instruction as it's executed.
+    CachedDecode    // Reuse handlers decoded the last time the same code ran, see ARM7TDMI::ExecuteCached.
+};
 }  // namespace cpu
@@ -161,6 +161,17 @@ public:
     /// @brief Copy the SPSR value of the current operating mode into CPSR.
     void LoadSPSR() { SetCPSR(std::bit_cast<u32>(spsr_)); }
 
+    ///-----------------------------------------------------------------------------------------------------------------------------
+    /// Snapshots
+    ///-----------------------------------------------------------------------------------------------------------------------------
+
+    /// @brief Copy of every register, including banked registers, CPSR, and SPSR.
+    using Snapshot = std::array<u32, 38>;
+
+    /// @brief Copy the current value of every register so it can be compared against the register state at another point in time.
+    /// @return Values of all registers.
+    Snapshot GetSnapshot() const;
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Save States
     ///-----------------------------------------------------------------------------------------------------------------------------
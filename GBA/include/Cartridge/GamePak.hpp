@@ -36,23 +36,59 @@ public:
     explicit GamePak(fs::path romPath, fs::path saveDir, EventScheduler& scheduler, SystemControl& systemControl);
 
     /// @brief Read an address in GamePak memory.
+    /// @tparam Length Memory access size of the read.
     /// @param addr Address to read from.
-    /// @param length Memory access size of the read.
     /// @return Number of cycles taken to read, value returned from the read, and whether it was an open-bus read.
-    MemReadData ReadMem(u32 addr, AccessSize length);
+    template <AccessSize Length>
+    MemReadData ReadMem(u32 addr);
+
+    /// @brief Advance the prefetch buffer for a read of GamePak ROM and determine how long the read takes.
+    /// @param addr Address being read, with any wait state 1/2 mirror offset removed.
+    /// @param length Memory access size of the read.
+    /// @param region Wait state region the read is from.
+    /// @return Number of cycles taken to read.
+    int AccessCycles(u32 addr, AccessSize length, WaitStateRegion region);
+
+    /// @brief Get the ROM contents for reading directly without going through ReadMem.
+    /// @return ROM data.
+    std::span<std::byte const> GetROM() const { return ROM_; }
+
+    /// @brief Prefetch buffer state, with timing stored relative to the current cycle.
+    struct PrefetchState
+    {
+        u32 NextSequentialAddr;
+        u64 CyclesSinceLastRead;
+        int PrefetchedWaitStates;
+
+        bool operator==(PrefetchState const&) const = default;
+    };
+
+    /// @brief Get the prefetch buffer state to compare against its state at another point in time.
+    /// @return Current prefetch buffer state.
+    PrefetchState GetPrefetchState() const
+    {
+        return {nextSequentialAddr_, scheduler_.GetTotalElapsedCycles() - lastReadCompletionCycle_, prefetchedWaitStates_};
+    }
+
+    /// @brief Shift the prefetch buffer's timing forward when the scheduler is advanced without emulating the cycles in between,
+    ///        so that it picks up in the same state it was in before the skip.
+    /// @param cycles Number of cycles that were skipped.
+    void SkipCycles(u64 cycles) { lastReadCompletionCycle_ += cycles; }
 
     /// @brief Write to an address in GamePak memory.
+    /// @tparam Length Memory access size of the write.
     /// @param addr Address to write to.
     /// @param val Value to write.
-    /// @param length Memory access size of the write.
     /// @return Number of cycles taken to write.
-    int WriteMem(u32 addr, u32 val, AccessSize length);
+    template <AccessSize Length>
+    int WriteMem(u32 addr, u32 val);
 
     /// @brief Read an address in GamePak memory when no GamePak is currently loaded.
+    /// @tparam Length Memory access size of the read.
     /// @param addr Address to read from.
-    /// @param length Memory access size of the read.
     /// @return Number of cycles taken to read, value returned from the read, and whether it was an open-bus read.
-    static MemReadData ReadUnloadedGamePakMem(u32 addr, AccessSize length);
+    template <AccessSize Length>
+    static MemReadData ReadUnloadedGamePakMem(u32 addr);
 
     /// @brief Check if GamePak was successfully loaded into memory.
     /// @return True if a GamePak is loaded.
@@ -62,6 +98,10 @@ public:
     /// @return Current ROM title.
     std::string GetTitle() const { return title_; }
 
+    /// @brief Get the four character game code from the ROM header.
+    /// @return Current ROM game code.
+    std::string GetGameCode() const { return gameCode_; }
+
     /// @brief Get the save path used for saving backup media and save states.
     /// @return Save path.
     fs::path GetSavePath() const { return savePath_; }
@@ -115,6 +155,7 @@ private:
     std::vector<std::byte> ROM_;
     std::unique_ptr<BackupMedia> backupMedia_;
     std::string title_;
+    std::string gameCode_;
     fs::path savePath_;
     bool gamePakLoaded_;
     bool containsEeprom_;
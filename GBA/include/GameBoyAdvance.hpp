@@ -15,11 +15,13 @@
 #include <GBA/include/DMA/DmaManager.hpp>
 #include <GBA/include/Keypad/Keypad.hpp>
 #include <GBA/include/Keypad/Registers.hpp>
+#include <GBA/include/Memory/MemoryMap.hpp>
 #include <GBA/include/PPU/PPU.hpp>
 #include <GBA/include/System/ClockManager.hpp>
 #include <GBA/include/System/EventScheduler.hpp>
 #include <GBA/include/System/SystemControl.hpp>
 #include <GBA/include/Timers/TimerManager.hpp>
+#include <GBA/include/Utilities/Functor.hpp>
 #include <GBA/include/Utilities/Types.hpp>
 
 namespace debug { class GameBoyAdvanceDebugger; }
@@ -36,7 +38,7 @@ public:
     GameBoyAdvance& operator=(GameBoyAdvance&&) = delete;
 
     /// @brief Initialize the GBA.
-    /// @param biosPath Path to BIOS ROM file.
+    /// @param biosPath Path to BIOS ROM file. If empty, the GBA boots straight into the GamePak using the built-in high level BIOS.
     /// @param romPath Path to GamePak ROM file.
     /// @param saveDir Path to directory to store save files and save states.
     /// @param vBlankCallback Function to be called whenever the GBA enters VBlank.
@@ -89,13 +91,15 @@ public:
     /// Save States
     ///-----------------------------------------------------------------------------------------------------------------------------
 
-    /// @brief Write data to save state file.
+    /// @brief Write data to save state file. The data is preceded by a header identifying the save state layout version.
     /// @param saveState Save state stream to write to.
     void Serialize(std::ofstream& saveState) const;
 
     /// @brief Load data from save state file.
     /// @param saveState Save state stream to read from.
-    void Deserialize(std::ifstream& saveState);
+    /// @return False if the file isn't a save state or was written with a different save state layout, in which case nothing is
+    ///         loaded. True otherwise.
+    bool Deserialize(std::ifstream& saveState);
 
     /// @brief Get the path of the file where backup media will be saved to.
     /// @return Backup media save file path.
@@ -116,7 +120,50 @@ public:
 
     /// @brief Set the CPU clock speed.
     /// @param clockSpeed New CPU clock speed in Hz.
-    void SetCpuClockSpeed(u32 clockSpeed) { clockMgr_.SetCpuClockSpeed(clockSpeed); }
+    void SetCpuClockSpeed(u32 clockSpeed);
+
+    /// @brief Set which frames the PPU draws. In Auto mode, the number of skipped frames follows the CPU clock speed so that
+    ///        roughly as many frames are drawn per second as when running at the default speed.
+    /// @param mode Frame skip mode.
+    /// @param framesToSkip Number of frames to skip after each drawn frame in Fixed mode. Ignored by other modes.
+    void SetFrameSkip(graphics::FrameSkipMode mode, u8 framesToSkip = 0);
+
+    /// @brief Set whether the PPU draws scanlines on a separate render thread while the CPU keeps running. Output is identical to
+    ///        drawing them during HBlank.
+    /// @param enabled Whether to render asynchronously.
+    void SetAsyncRendering(bool enabled) { ppu_.SetAsyncRendering(enabled); }
+
+    /// @brief Select how the CPU decodes instructions. Output is identical with every backend.
+    /// @param backend CPU backend to use.
+    void SetCpuBackend(cpu::CpuBackend backend);
+
+    /// @brief Get the current value of every CPU register, for comparing the state of two GBAs.
+    /// @return Snapshot of all CPU registers.
+    cpu::Registers::Snapshot GetRegisterSnapshot() const { return cpu_.GetRegisterSnapshot(); }
+
+    /// @brief Get the number of CPU cycles that have been emulated since power on.
+    /// @return Total number of emulated cycles.
+    u64 GetTotalElapsedCycles() const { return scheduler_.GetTotalElapsedCycles(); }
+
+    /// @brief Set whether BIOS functions that have a native implementation run natively instead of through the BIOS. Always enabled
+    ///        when using the built-in BIOS.
+    /// @param enabled Whether to use native BIOS functions.
+    void SetHleBios(bool enabled) { cpu_.SetHleBios(enabled || biosMgr_.UsingBuiltInBios()); }
+
+    /// @brief Choose whether idle loops are fast forwarded through based on the loaded ROM's game code. Skipping only removes loop
+    ///        iterations that would end in the exact state they started in, so this is an escape hatch for games that poll state the
+    ///        detector doesn't track. Does nothing if no GamePak is loaded.
+    /// @param gameCodes Four character header game codes of ROMs to disable idle loop skipping for.
+    void SetIdleLoopSkippingDisabledGameCodes(std::unordered_set<std::string> const& gameCodes);
+
+    /// @brief Set whether idle loops are fast forwarded through. Enabled by default. Overrides the choice made by
+    ///        SetIdleLoopSkippingDisabledGameCodes. Can be changed at any time and is not part of save states.
+    /// @param enabled Whether to skip idle loops.
+    void SetIdleLoopSkipping(bool enabled) { idleLoopSkipping_ = enabled; }
+
+    /// @brief Get the number of CPU cycles that were fast forwarded through instead of emulated because the CPU was idling.
+    /// @return Total number of skipped cycles.
+    u64 GetIdleCyclesSkipped() const { return idleCyclesSkipped_; }
 
     /// @brief Update the KEYINPUT register based on current user input.
     /// @param keyinput KEYINPUT value.
@@ -150,13 +197,26 @@ public:
     ///-----------------------------------------------------------------------------------------------------------------------------
 
     /// @brief Get a pointer to the pixel data of the most recently completed frame.
-    /// @return Pointer to raw pixel data.
+    /// @return Pointer to raw pixel data in the current pixel format.
     uchar* GetRawFrameBuffer() { return ppu_.GetRawFrameBuffer(); }
 
+    /// @brief Set the pixel format that completed frames are made available in. Front ends that draw 32 bit images should use
+    ///        XRGB8888 so that frames can be displayed without converting them.
+    /// @param format Pixel format to output.
+    void SetPixelFormat(graphics::PixelFormat format) { ppu_.SetPixelFormat(format); }
+
+    /// @brief Get the pixel format that completed frames are made available in.
+    /// @return Current pixel format.
+    graphics::PixelFormat GetPixelFormat() const { return ppu_.GetPixelFormat(); }
+
     /// @brief Get FPS counter from PPU.
     /// @return Number of times the PPU has entered VBlank since last check.
     int GetFPSCounter() { return ppu_.GetAndResetFPSCounter(); }
 
+    /// @brief Get the number of background tile lookups that hit and missed the PPU's decoded tile cache.
+    /// @return Tile cache statistics.
+    graphics::TileCacheStats GetTileCacheStats() const { return ppu_.GetTileCacheStats(); }
+
     /// @brief Get the title of the ROM currently running.
     /// @return Current ROM title.
     std::string GetTitle() const { return gamePak_ ? gamePak_->GetTitle() : ""; }
@@ -176,23 +236,60 @@ private:
     /// @return Whether the loop exited early due to encountering a breakpoint.
     bool MainLoop(size_t samples);
 
+    /// @brief Run CPU instructions back to back until the next scheduled event is due or an IO write occurs. Only events and IO
+    ///        writes can start DMAs, halt the CPU, or change the IRQ line, so none of those need to be checked between instructions
+    ///        in a batch. Breakpoints are not checked, so the per-instruction path must be used while any are set.
+    void RunCpuBatch();
+
+    /// @brief Called by the CPU after it branches back a few instructions. If nothing that the loop being run could observe has
+    ///        changed since the last time it branched back to the same place, each iteration until the next event would also end
+    ///        in that same state, so the scheduler is advanced past as many whole iterations as fit before the event.
+    void CheckIdleLoop();
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Bus functionality
     ///-----------------------------------------------------------------------------------------------------------------------------
 
-    /// @brief Route a memory read to the correct component.
+    /// @brief Map every page of the address space that can be accessed without going through a handler into the page tables.
+    void InitializePageTables();
+
+    /// @brief Route a memory read whose size is only known at runtime to the correct component.
     /// @param addr Address to read from.
     /// @param length Memory access size of the read.
     /// @return Value returned from the read and number of cycles taken to read.
     std::pair<u32, int> ReadMem(u32 addr, AccessSize length);
 
-    /// @brief Route a memory write to the correct component.
+    /// @brief Route a memory write whose size is only known at runtime to the correct component.
     /// @param addr Address to write to.
     /// @param val Value to write to memory.
     /// @param length Memory access size of the write.
     /// @return Number of cycles taken to write.
     int WriteMem(u32 addr, u32 val, AccessSize length);
 
+    /// @brief Route a memory read to the correct component, with alignment and page table access resolved at compile time.
+    /// @param addr Address to read from.
+    /// @return Value returned from the read and number of cycles taken to read.
+    template <AccessSize Length>
+    std::pair<u32, int> Read(u32 addr);
+
+    /// @brief Route a memory write to the correct component, with alignment and page table access resolved at compile time.
+    /// @param addr Address to write to.
+    /// @param val Value to write to memory.
+    /// @return Number of cycles taken to write.
+    template <AccessSize Length>
+    int Write(u32 addr, u32 val);
+
+    /// @brief Fetch an instruction for the CPU. Fetches from the region the CPU was last fetching from read straight out of that
+    ///        region's memory, and only a fetch from a different region goes through ReadMem.
+    /// @param addr Address to fetch from.
+    /// @param length Instruction size.
+    /// @return Fetched instruction and number of cycles taken to fetch it.
+    std::pair<u32, int> FetchInstruction(u32 addr, AccessSize length);
+
+    /// @brief Point the instruction fetch fast path at the memory region containing an address.
+    /// @param addr Address being fetched from.
+    void UpdateFetchRegion(u32 addr);
+
     /// @brief Read an address in EWRAM.
     /// @param addr Address to read from.
     /// @param length Memory access size of the read.
@@ -219,6 +316,15 @@ private:
     /// @return Number of cycles taken to write.
     int WriteIWRAM(u32 addr, u32 val, AccessSize length);
 
+    /// @brief Called by the CPU before it caches instructions decoded from an address. Work RAM pages that code is cached from are
+    ///        removed from the write page table so that every write to them is reported to the CPU.
+    /// @param addr Address of the code to cache.
+    /// @return Whether code at this address can be cached.
+    bool ProtectCode(u32 addr);
+
+    /// @brief Point each halfword of IO space at the handler of the component that owns it.
+    void InitializeIOHandlers();
+
     /// @brief Read an address corresponding to an IO register.
     /// @param addr Address to read from.
     /// @param length Memory access size of the read.
@@ -232,6 +338,18 @@ private:
     /// @return Number of cycles taken to write.
     int WriteIO(u32 addr, u32 val, AccessSize length);
 
+    /// @brief Read handler for IO addresses that aren't mapped to any register.
+    /// @return Open bus read.
+    MemReadData ReadUnmappedIO(u32, AccessSize) { return {1, 0, true}; }
+
+    /// @brief Read handler for serial registers, which aren't emulated.
+    /// @return Read of 0.
+    MemReadData ReadSerialIO(u32, AccessSize) { return {1, 0, false}; }
+
+    /// @brief Write handler for IO addresses whose writes are ignored.
+    /// @return Number of cycles taken to write.
+    int WriteIgnoredIO(u32, u32, AccessSize) { return 1; }
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Event handling
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -284,6 +402,66 @@ private:
     // Open bus
     u32 lastSuccessfulFetch_;
 
+    // Instruction fetch fast path
+    struct FetchRegion
+    {
+        u32 Start;
+        u32 Size;
+        std::byte const* Data;
+        int HalfwordCycles;
+        int WordCycles;
+        bool GamePak;
+        WaitStateRegion GamePakRegion;
+    };
+
+    FetchRegion fetchRegion_;
+
+    // IO dispatch, one handler per halfword of IO space
+    using IOReadHandler = Delegate<MemReadData(u32, AccessSize)>;
+    using IOWriteHandler = Delegate<int(u32, u32, AccessSize)>;
+    static constexpr u32 IO_HANDLER_RANGE = 0x400;
+
+    std::array<IOReadHandler, IO_HANDLER_RANGE / 2> ioReadHandlers_;
+    std::array<IOWriteHandler, IO_HANDLER_RANGE / 2> ioWriteHandlers_;
+
+    // Page tables. Pages with a null Data pointer are accessed through their region's handler. The read table maps plain memory
+    // that reads have no side effects on, and the write table only maps EWRAM and IWRAM since writes to video memory and ROM have
+    // side effects that the handlers deal with.
+    template <typename T>
+    struct PageTableEntry
+    {
+        T* Data;
+        u32 Mask;
+        u8 HalfwordCycles;
+        u8 WordCycles;
+    };
+
+    static constexpr u32 PAGE_TABLE_SHIFT = 15;
+    static constexpr u32 PAGE_SIZE = 1 << PAGE_TABLE_SHIFT;
+    static constexpr size_t PAGE_TABLE_SIZE = GAMEPAK_ROM_ADDR_MIN >> PAGE_TABLE_SHIFT;
+
+    std::array<PageTableEntry<std::byte const>, PAGE_TABLE_SIZE> readPageTable_;
+    std::array<PageTableEntry<std::byte>, PAGE_TABLE_SIZE> writePageTable_;
+
+    // CPU batching
+    bool batchInterrupted_;
+
+    // Idle loop skipping. Loops are only skipped while a batch is running since no events can fire and only IO writes can change
+    // the state the CPU sees before the batch's deadline.
+    struct IdleLoopState
+    {
+        cpu::Registers::Snapshot Registers;
+        cartridge::GamePak::PrefetchState Prefetch;
+        u64 Cycle;
+        u64 Deadline;
+        bool Valid;
+        bool SideEffects;
+    };
+
+    IdleLoopState idleLoop_;
+    bool idleLoopSkipping_;
+    u64 idleCyclesSkipped_;
+
     // Breakpoints
     std::unordered_set<u32> breakpoints_;
     u64 breakpointCycle_;
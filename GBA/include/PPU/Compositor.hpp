@@ -0,0 +1,68 @@
+#pragma once
+
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+enum class SpecialEffect : u8
+{
+    None = 0,
+    AlphaBlending,
+    BrightnessIncrease,
+    BrightnessDecrease
+};
+
+/// @brief Color special effect coefficients for a scanline. Each coefficient is a 1.4 fixed point value clamped to 16.
+struct BlendCoefficients
+{
+    u16 eva;
+    u16 evb;
+    u16 evy;
+};
+
+/// @brief Signature of a function that applies per-dot color special effects to a run of pixels.
+/// @param topColors bgr555 value of the top layer at each dot.
+/// @param bottomColors bgr555 value of the second layer at each dot. Only read where the effect is alpha blending.
+/// @param effects Effect to apply at each dot. Must already account for windows and target layers.
+/// @param coefficients Blending and brightness coefficients.
+/// @param output Array to write the final bgr555 value of each dot to.
+/// @param count Number of dots to composite.
+using CompositeFunction = void (*)(u16 const* topColors,
+                                   u16 const* bottomColors,
+                                   SpecialEffect const* effects,
+                                   BlendCoefficients coefficients,
+                                   u16* output,
+                                   size_t count);
+
+/// @brief Composite a run of pixels one at a time. Available on every host.
+void CompositeScalar(u16 const* topColors,
+                     u16 const* bottomColors,
+                     SpecialEffect const* effects,
+                     BlendCoefficients coefficients,
+                     u16* output,
+                     size_t count);
+
+/// @brief Composite a run of pixels 8 at a time. Only call if the host supports SSE2.
+void CompositeSse2(u16 const* topColors,
+                   u16 const* bottomColors,
+                   SpecialEffect const* effects,
+                   BlendCoefficients coefficients,
+                   u16* output,
+                   size_t count);
+
+/// @brief Composite a run of pixels 16 at a time. Only call if the host supports AVX2.
+void CompositeAvx2(u16 const* topColors,
+                   u16 const* bottomColors,
+                   SpecialEffect const* effects,
+                   BlendCoefficients coefficients,
+                   u16* output,
+                   size_t count);
+
+/// @brief Get the fastest compositing function supported by the host CPU.
+/// @return Pointer to compositing function.
+CompositeFunction SelectCompositeFunction();
+
+/// @brief Get the name of the compositing function that SelectCompositeFunction picks on this host.
+/// @return "avx2", "sse2", or "scalar".
+char const* SelectedCompositorName();
+}  // namespace graphics
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <array>
-#include <vector>
+#include <memory>
+#include <GBA/include/PPU/Compositor.hpp>
 #include <GBA/include/PPU/Registers.hpp>
 #include <GBA/include/Utilities/Types.hpp>
 
@@ -20,12 +21,11 @@ enum class PixelSrc : u8
     BD
 };
 
-enum class SpecialEffect : u8
+/// @brief Pixel format of completed frames.
+enum class PixelFormat : u8
 {
-    None = 0,
-    AlphaBlending,
-    BrightnessIncrease,
-    BrightnessDecrease
+    BGR555 = 0,     // 16 bits per pixel, native GBA format.
+    XRGB8888        // 32 bits per pixel stored as 0xFFRRGGBB, with each 5 bit channel scaled to the full 8 bit range.
 };
 
 struct WindowSettings
@@ -35,44 +35,10 @@ struct WindowSettings
     bool effectsEnabled;
 };
 
-class Pixel
-{
-public:
-    /// @brief Set default constructed pixels to be uninitialized.
-    Pixel() : initialized(false) {}
-
-    /// @brief Create a pixel.
-    /// @param src Source that generated this pixel.
-    /// @param bgr555 Color value of this pixel.
-    /// @param prio Priority (0-3) of this pixel.
-    /// @param transparency Whether this pixel is transparent.
-    /// @param semiTransparency If this is an OBJ pixel, then whether this pixel is part of a semi-transparent sprite.
-    Pixel(PixelSrc src, u16 bgr555, u8 prio, bool transparency, bool semiTransparency = false) :
-        source(src),
-        color(bgr555),
-        priority(prio),
-        transparent(transparency),
-        semiTransparent(semiTransparency),
-        initialized(true)
-    {
-    }
-
-    /// @brief Compare priority of two pixels. If A < B, then A has a higher priority and should be chosen to be drawn.
-    /// @param rhs Pixel to compare to.
-    /// @return Relative priority of two pixels.
-    bool operator<(Pixel const& rhs) const;
-
-    PixelSrc source;
-    u16 color;
-    u8 priority;
-    bool transparent;
-    bool semiTransparent;
-    bool initialized;
-};
-
 class FrameBuffer
 {
     using PixelBuffer = std::array<u16, LCD_WIDTH * LCD_HEIGHT>;
+    using HostPixelBuffer = std::array<u32, LCD_WIDTH * LCD_HEIGHT>;
 
 public:
     FrameBuffer(FrameBuffer const&) = delete;
@@ -83,21 +49,64 @@ public:
     /// @brief Initialize empty frame buffers.
     FrameBuffer();
 
-    /// @brief Add a pixel to be considered for drawing at the specified dot on the current scanline.
-    /// @param pixel Pixel to potentially be drawn.
-    /// @param dot Dot on the current scanline to add pixel at.
-    void PushPixel(Pixel pixel, u8 dot);
+    /// @brief Start drawing a background on the current scanline. Every dot of that layer starts out transparent.
+    /// @param bgIndex Index of background to draw (0-3).
+    void BeginBackgroundLayer(u8 bgIndex)
+    {
+        u8 layer = bgIndex + 1;
+        layerKeys_[layer].fill(TRANSPARENT_KEY);
+        activeLayers_ |= (1 << layer);
+    }
 
-    /// @brief Get a sprite pixel on the current scanline at a particular dot.
-    /// @param dot Dot to get sprite pixel at.
-    /// @return Reference to pixel at specified dot.
-    Pixel& GetSpritePixel(size_t dot) { return spriteScanline_.at(dot); }
+    /// @brief Set the pixel of a background at the specified dot on the current scanline.
+    /// @param bgIndex Index of background the pixel belongs to (0-3).
+    /// @param dot Dot on the current scanline to set pixel at.
+    /// @param bgr555 Color value of this pixel.
+    /// @param priority Priority (0-3) of this pixel.
+    /// @param transparent Whether this pixel is transparent.
+    void SetBackgroundPixel(u8 bgIndex, u8 dot, u16 bgr555, u8 priority, bool transparent)
+    {
+        u8 layer = bgIndex + 1;
+        layerColors_[layer][dot] = bgr555;
+        layerKeys_[layer][dot] = transparent ? TRANSPARENT_KEY : SortKey(priority, layer);
+    }
 
-    /// @brief Merge the sprite pixels scanline buffer into the main scanline buffer.
-    void PushSpritePixels();
+    /// @brief Start drawing sprites on the current scanline. Every dot of the OBJ layer starts out transparent.
+    void BeginSpriteLayer()
+    {
+        layerKeys_[OBJ_LAYER].fill(TRANSPARENT_KEY);
+        activeLayers_ |= (1 << OBJ_LAYER);
+    }
 
-    /// @brief Uninitialize all pixels in sprite scanline buffer.
-    void ClearSpritePixels();
+    /// @brief Draw a sprite pixel at the specified dot on the current scanline if it has a higher priority than any sprite pixel
+    ///        already drawn there. Sprites must be drawn in OAM order. A pixel that isn't drawn because it's transparent or outside
+    ///        of the OBJ window still raises the priority of an opaque sprite pixel already drawn at that dot.
+    /// @param dot Dot on the current scanline to draw pixel at.
+    /// @param bgr555 Color value of this pixel.
+    /// @param priority Priority (0-3) of this pixel.
+    /// @param transparent Whether this pixel is transparent.
+    /// @param semiTransparent Whether this pixel is part of a semi-transparent sprite.
+    void SetSpritePixel(u8 dot, u16 bgr555, u8 priority, bool transparent, bool semiTransparent)
+    {
+        u8 key = SortKey(priority, OBJ_LAYER);
+        u8& currentKey = layerKeys_[OBJ_LAYER][dot];
+
+        if (key >= currentKey)
+        {
+            return;
+        }
+
+        if (windowScanline_[dot].objEnabled && !transparent)
+        {
+            layerColors_[OBJ_LAYER][dot] = bgr555;
+            objSemiTransparent_[dot] = semiTransparent;
+            currentKey = key;
+        }
+        else if (currentKey != TRANSPARENT_KEY)
+        {
+            currentKey = key;
+        }
+    }
 
     /// @brief Render the current scanline of pixels to the frame buffer.
     /// @param backdrop Pixel color of backdrop layer.
@@ -120,20 +129,55 @@ public:
     WindowSettings& GetWindowSettings(u8 dot) { return windowScanline_.at(dot); }
 
     /// @brief Get a pointer to the pixel data of the most recently completed frame.
-    /// @return Pointer to raw pixel data.
+    /// @return Pointer to raw pixel data in the current pixel format.
     uchar* GetRawFrameBuffer();
 
+    /// @brief Set the pixel format that completed frames are made available in. Takes effect starting with the next scanline.
+    /// @param format Pixel format to output.
+    void SetPixelFormat(PixelFormat format);
+
+    /// @brief Get the pixel format that completed frames are made available in.
+    /// @return Current pixel format.
+    PixelFormat GetPixelFormat() const { return pixelFormat_; }
+
     /// @brief Reset all scanline buffers and the pixel index for loading a save state.
     void Reset();
 
 private:
-    // Current scanline data
-    std::array<std::vector<Pixel>, LCD_WIDTH> scanline_;
-    std::array<Pixel, LCD_WIDTH> spriteScanline_;
+    /// @brief Layers are indexed by PixelSrc. The backdrop has no layer since it's always fully opaque.
+    static constexpr size_t LAYER_COUNT = 5;
+    static constexpr u8 OBJ_LAYER = static_cast<u8>(PixelSrc::OBJ);
+
+    /// @brief Sort key of a dot with nothing drawn on it. Sorts below every opaque pixel.
+    static constexpr u8 TRANSPARENT_KEY = U8_MAX;
+
+    /// @brief Get the sort key of an opaque pixel. When two pixels overlap, the one with the lower key is drawn on top. Priority
+    ///        decides first, and ties are broken by layer so that OBJ is above BG0, which is above BG1, and so on.
+    /// @param priority Priority (0-3) of pixel, or 4 for the backdrop.
+    /// @param layer Layer the pixel belongs to.
+    /// @return Sort key of pixel. The layer can be recovered from the lowest three bits.
+    static constexpr u8 SortKey(u8 priority, u8 layer) { return (priority << 3) | layer; }
+
+    // Current scanline data. Each layer has its own color and sort key plane, and only layers set in activeLayers_ are drawn.
+    std::array<std::array<u16, LCD_WIDTH>, LAYER_COUNT> layerColors_;
+    std::array<std::array<u8, LCD_WIDTH>, LAYER_COUNT> layerKeys_;
+    std::array<bool, LCD_WIDTH> objSemiTransparent_;
+    u8 activeLayers_;
     std::array<WindowSettings, LCD_WIDTH> windowScanline_;
 
+    // Resolved layers and effect of each dot on the current scanline, consumed by composite_
+    std::array<u16, LCD_WIDTH> topColors_;
+    std::array<u16, LCD_WIDTH> bottomColors_;
+    std::array<SpecialEffect, LCD_WIDTH> effects_;
+    CompositeFunction composite_;
+
+    /// @brief Convert the scanline that was just rendered to the host pixel format if needed, and advance to the next scanline.
+    void FinishScanline();
+
     // Raw pixel data
     std::array<PixelBuffer, 3> frameBuffers_;
+    std::unique_ptr<std::array<HostPixelBuffer, 3>> hostFrameBuffers_;
+    PixelFormat pixelFormat_;
     size_t pixelIndex_;
     u8 activeBufferIndex_;
 };
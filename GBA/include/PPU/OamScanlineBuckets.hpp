@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <GBA/include/PPU/FrameBuffer.hpp>
+#include <GBA/include/PPU/VramViews.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+/// @brief One bit per OAM entry, where bit i of word (i / 64) represents sprite i.
+using SpriteMask = std::array<u64, 2>;
+
+/// @brief Size and position of a sprite as decoded from its OAM entry.
+struct SpriteBounds
+{
+    i16 x;          // X-coordinate of the top left corner, or of the center of the sprite within its double size area.
+    i16 y;          // Y-coordinate of the top left corner, or of the center of the sprite within its double size area.
+    u8 width;       // Width of the sprite in pixels.
+    u8 height;      // Height of the sprite in pixels.
+    u8 firstLine;   // First visible scanline the sprite covers.
+    u8 lineCount;   // Number of visible scanlines the sprite covers, starting from firstLine.
+};
+
+/// @brief Lists of which sprites intersect each visible scanline. OAM entries are only decoded again after attribute 0 or 1 has
+///        been written to, so scanlines only touch the sprites that are actually on them.
+class OamScanlineBuckets
+{
+    static constexpr u8 SPRITE_COUNT = 128;
+
+public:
+    OamScanlineBuckets(OamScanlineBuckets const&) = delete;
+    OamScanlineBuckets& operator=(OamScanlineBuckets const&) = delete;
+    OamScanlineBuckets(OamScanlineBuckets&&) = delete;
+    OamScanlineBuckets& operator=(OamScanlineBuckets&&) = delete;
+
+    /// @brief Initialize buckets that decode every OAM entry on first use.
+    OamScanlineBuckets();
+
+    /// @brief Get the sprites that intersect a scanline, in OAM order.
+    /// @param oam View of OAM.
+    /// @param scanline Visible scanline in the range [0, 159].
+    /// @param objWindow True to get OBJ window sprites, false to get visible sprites.
+    /// @return Mask of sprites on the scanline. Disabled sprites and sprites with illegal modes or sizes are never included.
+    SpriteMask GetSprites(Oam oam, u8 scanline, bool objWindow)
+    {
+        if ((dirty_[0] | dirty_[1]) != 0)
+        {
+            Update(oam);
+        }
+
+        SpriteMask const& sprites = scanlines_[scanline];
+
+        if (objWindow)
+        {
+            return {sprites[0] & objWindowSprites_[0], sprites[1] & objWindowSprites_[1]};
+        }
+
+        return {sprites[0] & ~objWindowSprites_[0], sprites[1] & ~objWindowSprites_[1]};
+    }
+
+    /// @brief Get the size and position of a sprite returned by GetSprites.
+    /// @param index OAM index of the sprite.
+    /// @return Sprite bounds.
+    SpriteBounds const& GetBounds(u8 index) const { return bounds_[index]; }
+
+    /// @brief Mark the OAM entry containing a write as needing to be decoded again.
+    /// @param offset Offset into OAM of the write. Writes never cross a word boundary.
+    void Invalidate(u32 offset)
+    {
+        // Only attributes 0 and 1 affect which scanlines a sprite is on. Attribute 2 and the affine parameter are ignored.
+        if ((offset % sizeof(OamEntry)) < 4)
+        {
+            u8 index = offset / sizeof(OamEntry);
+            dirty_[index / 64] |= (1ULL << (index % 64));
+        }
+    }
+
+    /// @brief Mark every OAM entry as needing to be decoded again.
+    void InvalidateAll();
+
+private:
+    /// @brief Decode every invalidated OAM entry and move it to the buckets of the scanlines it now covers.
+    /// @param oam View of OAM.
+    void Update(Oam oam);
+
+    /// @brief Decode the size and position of an OAM entry.
+    /// @param entry OAM entry to decode.
+    /// @param bounds Bounds to populate. If the sprite isn't displayed, lineCount is set to 0.
+    static void DecodeBounds(OamEntry const& entry, SpriteBounds& bounds);
+
+    std::array<SpriteMask, LCD_HEIGHT> scanlines_;
+    std::array<SpriteBounds, SPRITE_COUNT> bounds_;
+    SpriteMask objWindowSprites_;
+    SpriteMask dirty_;
+};
+}  // namespace graphics
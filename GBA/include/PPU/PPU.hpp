@@ -4,9 +4,13 @@
 #include <cstddef>
 #include <cstring>
 #include <fstream>
+#include <memory>
+#include <span>
 #include <vector>
 #include <GBA/include/PPU/FrameBuffer.hpp>
+#include <GBA/include/PPU/OamScanlineBuckets.hpp>
 #include <GBA/include/PPU/Registers.hpp>
+#include <GBA/include/PPU/TileCache.hpp>
 #include <GBA/include/PPU/VramViews.hpp>
 #include <GBA/include/System/EventScheduler.hpp>
 #include <GBA/include/System/SystemControl.hpp>
@@ -17,6 +21,18 @@ namespace debug { class PPUDebugger; }
 
 namespace graphics
 {
+class RenderThread;
+
+/// @brief Which frames the PPU draws. Skipped frames still run all PPU timing, so scanline events, interrupts, DMA triggers, and
+///        affine reference point updates are unaffected, but no background or sprite pixels are evaluated.
+enum class FrameSkipMode : u8
+{
+    Off = 0,        // Draw every frame.
+    Fixed,          // Draw one frame, then skip a fixed number of frames.
+    Auto,           // Draw one frame for every multiple of the default CPU clock speed that emulation is running at.
+    NeverRender     // Never draw. For headless runs that only inspect memory.
+};
+
 /// @brief Pixel Processing Unit.
 class PPU
 {
@@ -32,56 +48,109 @@ public:
     /// @param systemControl Reference to system control to post PPU interrupts to.
     explicit PPU(EventScheduler& scheduler, SystemControl& systemControl);
 
-    /// @brief Get a pointer to the pixel data of the most recently completed frame.
+    /// @brief Stop the render thread if asynchronous rendering is enabled.
+    ~PPU();
+
+    /// @brief Get a pointer to the pixel data of the most recently completed frame. With asynchronous rendering, first waits for
+    ///        the render thread to finish every frame the emulator has completed.
     /// @return Pointer to raw pixel data.
-    uchar* GetRawFrameBuffer() { return frameBuffer_.GetRawFrameBuffer(); }
+    uchar* GetRawFrameBuffer();
+
+    /// @brief Set the pixel format that completed frames are made available in.
+    /// @param format Pixel format to output.
+    void SetPixelFormat(PixelFormat format);
+
+    /// @brief Get the pixel format that completed frames are made available in.
+    /// @return Current pixel format.
+    PixelFormat GetPixelFormat() const { return frameBuffer_.GetPixelFormat(); }
+
+    /// @brief Set which frames get drawn, starting with the next frame. The most recently drawn frame stays available while frames
+    ///        are skipped.
+    /// @param mode Frame skip mode.
+    /// @param framesToSkip Number of frames to skip after each drawn frame in Fixed and Auto modes.
+    void SetFrameSkip(FrameSkipMode mode, u8 framesToSkip);
+
+    /// @brief Get the current frame skip mode.
+    /// @return Frame skip mode.
+    FrameSkipMode GetFrameSkipMode() const { return frameSkipMode_; }
+
+    /// @brief Set whether scanlines are drawn on a separate render thread while emulation continues, instead of during HBlank.
+    ///        Output is identical either way. Can be changed at any time.
+    /// @param enabled Whether to render asynchronously.
+    void SetAsyncRendering(bool enabled);
+
+    /// @brief Check whether scanlines are drawn on a separate render thread.
+    /// @return Whether asynchronous rendering is enabled.
+    bool AsyncRenderingEnabled() const { return renderThread_ != nullptr; }
 
     /// @brief Get the number of frames that have been generated since the last check. Reset the counter.
     /// @return Number of times the PPU has entered VBlank since last check.
     int GetAndResetFPSCounter() { int counter = fpsCounter_; fpsCounter_ = 0; return counter; }
 
+    /// @brief Get the number of background tile lookups that hit and missed the decoded tile cache.
+    /// @return Tile cache statistics, including lookups made by the render thread.
+    TileCacheStats GetTileCacheStats() const;
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Bus functionality
     ///-----------------------------------------------------------------------------------------------------------------------------
 
     /// @brief Read an address in PRAM.
+    /// @tparam Length Memory access size of the read.
     /// @param addr Address to read from.
-    /// @param length Memory access size of the read.
     /// @return Number of cycles taken to read, value returned from the read, and whether it was an open-bus read.
-    MemReadData ReadPRAM(u32 addr, AccessSize length);
+    template <AccessSize Length>
+    MemReadData ReadPRAM(u32 addr);
 
     /// @brief Write to an address in PRAM.
+    /// @tparam Length Memory access size of the write.
     /// @param addr Address to write to.
     /// @param val Value to write.
-    /// @param length Memory access size of the write.
     /// @return Number of cycles taken to write.
-    int WritePRAM(u32 addr, u32 val, AccessSize length);
+    template <AccessSize Length>
+    int WritePRAM(u32 addr, u32 val);
 
     /// @brief Read an address in OAM.
+    /// @tparam Length Memory access size of the read.
     /// @param addr Address to read from.
-    /// @param length Memory access size of the read.
     /// @return Number of cycles taken to read, value returned from the read, and whether it was an open-bus read.
-    MemReadData ReadOAM(u32 addr, AccessSize length);
+    template <AccessSize Length>
+    MemReadData ReadOAM(u32 addr);
 
     /// @brief Write to an address in OAM.
+    /// @tparam Length Memory access size of the write.
     /// @param addr Address to write to.
     /// @param val Value to write.
-    /// @param length Memory access size of the write.
     /// @return Number of cycles taken to write.
-    int WriteOAM(u32 addr, u32 val, AccessSize length);
+    template <AccessSize Length>
+    int WriteOAM(u32 addr, u32 val);
 
     /// @brief Read an address in VRAM.
+    /// @tparam Length Memory access size of the read.
     /// @param addr Address to read from.
-    /// @param length Memory access size of the read.
     /// @return Number of cycles taken to read, value returned from the read, and whether it was an open-bus read.
-    MemReadData ReadVRAM(u32 addr, AccessSize length);
+    template <AccessSize Length>
+    MemReadData ReadVRAM(u32 addr);
 
     /// @brief Write to an address in VRAM.
+    /// @tparam Length Memory access size of the write.
     /// @param addr Address to write to.
     /// @param val Value to write.
-    /// @param length Memory access size of the write.
     /// @return Number of cycles taken to write.
-    int WriteVRAM(u32 addr, u32 val, AccessSize length);
+    template <AccessSize Length>
+    int WriteVRAM(u32 addr, u32 val);
+
+    /// @brief Get the contents of PRAM so the bus can read it directly without going through ReadPRAM.
+    /// @return View of PRAM.
+    std::span<std::byte const> GetPRAM() const { return PRAM_; }
+
+    /// @brief Get the contents of OAM so the bus can read it directly without going through ReadOAM.
+    /// @return View of OAM.
+    std::span<std::byte const> GetOAM() const { return OAM_; }
+
+    /// @brief Get the contents of VRAM so the bus can read it directly without going through ReadVRAM.
+    /// @return View of VRAM.
+    std::span<std::byte const> GetVRAM() const { return VRAM_; }
 
     /// @brief Read an address mapped to PPU registers.
     /// @param addr Address of PPU register(s).
@@ -96,6 +165,12 @@ public:
     /// @return Number of cycles taken to write.
     int WriteReg(u32 addr, u32 val, AccessSize length);
 
+    /// @brief Read DISPSTAT and/or VCOUNT without checking for unused or write-only registers.
+    /// @param addr Address of DISPSTAT or VCOUNT.
+    /// @param length Memory access size of the read.
+    /// @return Number of cycles taken to read, value of the requested register(s), and whether it was an open-bus read.
+    MemReadData ReadDispstatVcount(u32 addr, AccessSize length);
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Event Handlers
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -129,6 +204,13 @@ public:
     void Deserialize(std::ifstream& saveState);
 
 private:
+    /// @brief Initialize a PPU without scheduling any events.
+    /// @param scheduler Reference to event scheduler.
+    /// @param systemControl Reference to system control.
+    /// @param sharedFrameBuffer Frame buffer to draw into, or nullptr to create one. Render-only PPUs used by a render thread draw
+    ///                          into the frame buffer of the PPU that owns the thread.
+    PPU(EventScheduler& scheduler, SystemControl& systemControl, FrameBuffer* sharedFrameBuffer);
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Register access/updates
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -166,7 +248,7 @@ private:
     /// @brief Set internal register corresponding to BG3Y.
     void SetBG3RefY();
 
-    /// @brief Increment BG2 and BG3 reference points after a scanline is rendered.
+    /// @brief Increment BG2 and BG3 reference points after each visible scanline, whether or not it was rendered.
     void IncrementAffineBackgroundReferencePoints();
 
     /// @brief Handle writes to the DISPSTAT and VCOUNT registers to avoid writing to read only bits.
@@ -234,6 +316,10 @@ private:
     /// @brief Evaluate sprites, window, and background layers on the current scanline.
     void EvaluateScanline();
 
+    /// @brief Decide whether the next frame gets drawn based on the frame skip settings.
+    /// @return Whether to draw the next frame.
+    bool RenderNextFrame();
+
     /// @brief Render background pixels in mode 0.
     void RenderMode0Scanline();
 
@@ -285,7 +371,7 @@ private:
     /// Sprites
     ///-----------------------------------------------------------------------------------------------------------------------------
 
-    /// @brief Render sprites and mix with background.
+    /// @brief Render the sprites on the current scanline and mix with background.
     /// @param windowSettingsPtr Pointer to OBJ window settings, or nullptr if rendering a visible sprites.
     void EvaluateOAM(WindowSettings* windowSettingsPtr = nullptr);
 
@@ -336,14 +422,27 @@ private:
     std::array<std::byte, PRAM_SIZE> PRAM_;
     alignas(OamEntry) std::array<std::byte, OAM_SIZE> OAM_;
     std::array<std::byte, VRAM_SIZE> VRAM_;
+    OamScanlineBuckets oamBuckets_;
+    TileCache tileCache_;
 
     // Registers
     std::array<std::byte, 0x58> registers_;
 
-    // Frame buffer
-    FrameBuffer frameBuffer_;
+    // Frame buffer. Render-only PPUs draw into the frame buffer of the PPU that owns their render thread. Per-pixel loops bind a
+    // local reference to it so that it isn't reloaded from this PPU after every pixel is stored.
+    std::unique_ptr<FrameBuffer> ownedFrameBuffer_;
+    FrameBuffer& frameBuffer_;
     int fpsCounter_;
 
+    // Frame skip
+    FrameSkipMode frameSkipMode_;
+    u8 framesToSkip_;
+    u8 framesSkipped_;
+    bool renderingFrame_;
+
+    // Asynchronous rendering
+    std::unique_ptr<RenderThread> renderThread_;
+
     // External components
     EventScheduler& scheduler_;
     SystemControl& systemControl_;
@@ -351,5 +450,8 @@ private:
     // VRAM views
     friend class debug::PPUDebugger;
     friend class RegularScreenBlockScanlineView;
+
+    // Render-only PPU and its memory
+    friend class RenderThread;
 };
 }  // namespace graphics
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <GBA/include/Memory/MemoryMap.hpp>
+#include <GBA/include/PPU/PPU.hpp>
+#include <GBA/include/Utilities/CommonUtils.hpp>
+#include <GBA/include/Utilities/RingBuffer.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+/// @brief Worker thread that draws scanlines on behalf of a PPU. At each HBlank the PPU queues a snapshot of the state that
+///        rendering depends on, and every write to PRAM, OAM, and VRAM is queued in between those snapshots. The worker keeps its
+///        own copy of video memory in a render-only PPU, replays the writes in order, and draws each scanline into the frame
+///        buffer of the PPU that owns it, so the output is identical to drawing synchronously.
+class RenderThread
+{
+    static constexpr size_t MEMORY_WRITE_QUEUE_SIZE = 32 * KiB;
+    static constexpr size_t COMMAND_QUEUE_SIZE = 512;
+
+public:
+    RenderThread() = delete;
+    RenderThread(RenderThread const&) = delete;
+    RenderThread& operator=(RenderThread const&) = delete;
+    RenderThread(RenderThread&&) = delete;
+    RenderThread& operator=(RenderThread&&) = delete;
+
+    /// @brief Copy the current contents of video memory from a PPU and start the worker thread.
+    /// @param ppu PPU to draw scanlines for.
+    explicit RenderThread(PPU& ppu);
+
+    /// @brief Draw everything that is still queued, then stop the worker thread.
+    ~RenderThread();
+
+    /// @brief Queue the word containing a write to PRAM, OAM, or VRAM after the PPU has written it. Only call from the emulation
+    ///        thread.
+    /// @param addr Address that was written, with mirroring already resolved.
+    void QueueMemoryWrite(u32 addr)
+    {
+        u32 alignedAddr = addr & ~0x03;
+        u32 val;
+
+        if (alignedAddr < VRAM_ADDR_MIN)
+        {
+            val = MemCpyInit<u32>(&ppu_.PRAM_[alignedAddr - PRAM_ADDR_MIN]);
+        }
+        else if (alignedAddr < OAM_ADDR_MIN)
+        {
+            val = MemCpyInit<u32>(&ppu_.VRAM_[alignedAddr - VRAM_ADDR_MIN]);
+        }
+        else
+        {
+            val = MemCpyInit<u32>(&ppu_.OAM_[alignedAddr - OAM_ADDR_MIN]);
+        }
+
+        MemoryWrite write = {alignedAddr, val};
+
+        while (!memoryWrites_.Write(&write, 1))
+        {
+            // The worker only drains writes that aren't needed by a queued command once it runs out of commands.
+            WakeWorker();
+            std::this_thread::yield();
+        }
+
+        ++memoryWritesQueued_;
+    }
+
+    /// @brief Queue the current scanline to be drawn using the PPU's current registers, affine reference points, and window state.
+    ///        Only call from the emulation thread.
+    void QueueScanline();
+
+    /// @brief Queue the end of the frame currently being drawn. Only call from the emulation thread.
+    void QueueEndOfFrame();
+
+    /// @brief Wait until every frame that has been queued so far has been drawn. Can be called from any thread.
+    void WaitForQueuedFrames();
+
+    /// @brief Wait until the worker has processed everything queued so far and is idle. Only call from the emulation thread.
+    void Synchronize();
+
+    /// @brief Copy the current contents of video memory from the PPU to the worker's copy. Only call after Synchronize.
+    void ReloadMemory();
+
+    /// @brief Get the number of background tile lookups that hit and missed the worker's decoded tile cache. Only call after
+    ///        Synchronize.
+    /// @return Tile cache statistics.
+    TileCacheStats GetTileCacheStats() const { return renderer_.tileCache_.GetStats(); }
+
+private:
+    enum class CommandType : u8
+    {
+        DrawScanline,
+        EndFrame,
+        Synchronize
+    };
+
+    /// @brief Word written to PRAM, OAM, or VRAM.
+    struct MemoryWrite
+    {
+        u32 addr;
+        u32 val;
+    };
+
+    /// @brief Command for the worker, along with the state needed to draw a scanline.
+    struct Command
+    {
+        CommandType type;
+        bool window0EnabledOnScanline;
+        bool window1EnabledOnScanline;
+        u64 memoryWritesBefore;
+        i32 bg2RefX;
+        i32 bg2RefY;
+        i32 bg3RefX;
+        i32 bg3RefY;
+        decltype(PPU::registers_) registers;
+    };
+
+    /// @brief Add a command to the command queue and wake the worker if it's waiting for one.
+    /// @param command Command to queue. Its memory write count is filled in here.
+    void QueueCommand(Command& command);
+
+    /// @brief Wake the worker if it's waiting for more work.
+    void WakeWorker();
+
+    /// @brief Worker thread loop.
+    void Run();
+
+    /// @brief Process all queued commands, or all queued memory writes if there are no commands.
+    /// @return Whether there was anything to process.
+    bool ProcessQueuedWork();
+
+    /// @brief Apply queued memory writes to the worker's copy of video memory.
+    /// @param count Number of writes to apply.
+    void ApplyMemoryWrites(u64 count);
+
+    /// @brief Run a single command.
+    /// @param command Command to run.
+    void RunCommand(Command const& command);
+
+    // PPUs
+    PPU& ppu_;
+    PPU renderer_;
+
+    // Queues
+    RingBuffer<MemoryWrite, MEMORY_WRITE_QUEUE_SIZE> memoryWrites_;
+    RingBuffer<Command, COMMAND_QUEUE_SIZE> commands_;
+    u64 memoryWritesQueued_;
+    u64 memoryWritesApplied_;
+    u32 commandsQueued_;
+
+    // Synchronization
+    std::atomic<u32> wakeCounter_;
+    std::atomic<u32> commandsCompleted_;
+    std::atomic<u32> framesQueued_;
+    std::atomic<u32> framesCompleted_;
+    std::atomic<bool> stopRequested_;
+
+    std::thread worker_;
+};
+}  // namespace graphics
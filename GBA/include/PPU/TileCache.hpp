@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <GBA/include/PPU/VramViews.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+/// @brief Tile bitmap with one palette index per pixel, indexed by [y][x].
+using DecodedTile = std::array<std::array<u8, 8>, 8>;
+
+/// @brief Number of tile lookups that were served from the cache and that had to decode VRAM.
+struct TileCacheStats
+{
+    u64 hits;
+    u64 misses;
+};
+
+/// @brief Cache of background tiles decoded from the background char blocks. Tiles are only decoded again after the VRAM backing
+///        them has been written to, so backgrounds whose tiles don't change skip decoding entirely.
+class TileCache
+{
+    static constexpr u32 BG_CHAR_BLOCKS_SIZE = 4 * CHAR_BLOCK_SIZE;
+    static constexpr u32 TILE_4_COUNT = BG_CHAR_BLOCKS_SIZE / sizeof(CharBlockEntry4);
+    static constexpr u32 TILE_8_COUNT = BG_CHAR_BLOCKS_SIZE / sizeof(CharBlockEntry8);
+
+public:
+    TileCache(TileCache const&) = delete;
+    TileCache& operator=(TileCache const&) = delete;
+    TileCache(TileCache&&) = delete;
+    TileCache& operator=(TileCache&&) = delete;
+
+    /// @brief Initialize an empty tile cache.
+    TileCache();
+
+    /// @brief Get a decoded 4bpp background tile.
+    /// @param vram Span representing all of VRAM.
+    /// @param charBaseBlock Base char block index in the range [0, 3].
+    /// @param index Tile index within the char block.
+    /// @return Decoded tile. Tiles past the end of the background char blocks are fully transparent.
+    DecodedTile const& Get4bppTile(VramSpan vram, u8 charBaseBlock, u16 index)
+    {
+        u32 tileIndex = ((charBaseBlock * CHAR_BLOCK_SIZE) / sizeof(CharBlockEntry4)) + index;
+
+        if (tileIndex >= TILE_4_COUNT)
+        {
+            return transparentTile_;
+        }
+
+        if (valid4_[tileIndex])
+        {
+            ++stats_.hits;
+        }
+        else
+        {
+            Decode4bppTile(vram, tileIndex);
+        }
+
+        return tiles4_[tileIndex];
+    }
+
+    /// @brief Get a decoded 8bpp background tile.
+    /// @param vram Span representing all of VRAM.
+    /// @param charBaseBlock Base char block index in the range [0, 3].
+    /// @param index Tile index within the char block.
+    /// @return Decoded tile. Tiles past the end of the background char blocks are fully transparent.
+    DecodedTile const& Get8bppTile(VramSpan vram, u8 charBaseBlock, u16 index)
+    {
+        u32 tileIndex = ((charBaseBlock * CHAR_BLOCK_SIZE) / sizeof(CharBlockEntry8)) + index;
+
+        if (tileIndex >= TILE_8_COUNT)
+        {
+            return transparentTile_;
+        }
+
+        if (valid8_[tileIndex])
+        {
+            ++stats_.hits;
+        }
+        else
+        {
+            Decode8bppTile(vram, tileIndex);
+        }
+
+        return tiles8_[tileIndex];
+    }
+
+    /// @brief Mark any tile that overlaps a VRAM write as needing to be decoded again.
+    /// @param offset Offset into VRAM of the write. Writes never cross a word boundary.
+    void Invalidate(u32 offset)
+    {
+        if (offset < BG_CHAR_BLOCKS_SIZE)
+        {
+            valid4_[offset / sizeof(CharBlockEntry4)] = false;
+            valid8_[offset / sizeof(CharBlockEntry8)] = false;
+        }
+    }
+
+    /// @brief Mark every tile as needing to be decoded again.
+    void InvalidateAll();
+
+    /// @brief Get the number of cache hits and misses since the cache was created.
+    /// @return Cache statistics.
+    TileCacheStats GetStats() const { return stats_; }
+
+private:
+    /// @brief Decode a 4bpp tile from VRAM into the cache.
+    /// @param vram Span representing all of VRAM.
+    /// @param tileIndex Index of 32 byte tile from the start of VRAM.
+    void Decode4bppTile(VramSpan vram, u32 tileIndex);
+
+    /// @brief Decode an 8bpp tile from VRAM into the cache.
+    /// @param vram Span representing all of VRAM.
+    /// @param tileIndex Index of 64 byte tile from the start of VRAM.
+    void Decode8bppTile(VramSpan vram, u32 tileIndex);
+
+    std::array<DecodedTile, TILE_4_COUNT> tiles4_;
+    std::array<DecodedTile, TILE_8_COUNT> tiles8_;
+    std::array<bool, TILE_4_COUNT> valid4_;
+    std::array<bool, TILE_8_COUNT> valid8_;
+    DecodedTile transparentTile_;
+
+    TileCacheStats stats_;
+};
+}  // namespace graphics
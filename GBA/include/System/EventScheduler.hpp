@@ -1,12 +1,11 @@
 #pragma once
 
-#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <fstream>
-#include <functional>
 #include <optional>
 #include <type_traits>
-#include <unordered_map>
-#include <vector>
+#include <GBA/include/Utilities/Functor.hpp>
 #include <GBA/include/Utilities/Types.hpp>
 
 /// @brief Enum of various event types that can be scheduled to execute. Must be registered before scheduling.
@@ -60,7 +59,7 @@ struct Event
     ///        determine priority by their order in the EventType enum (lower = higher priority).
     /// @param rhs Event to compare priority to.
     /// @return True if this is lower priority than the event this is being compared to.
-    bool operator>(Event const& rhs);
+    bool operator>(Event const& rhs) const;
 
     EventType eventType_;
     u64 cycleQueued_;
@@ -72,7 +71,7 @@ static_assert(std::is_trivial_v<Event>, "Event must be trivial type");
 /// @brief Scheduler for scheduling and dispatching system events.
 class EventScheduler
 {
-    using Callback = std::function<void(int)>;
+    using Callback = Delegate<void(int)>;
 
 public:
     EventScheduler(EventScheduler const&) = delete;
@@ -80,7 +79,7 @@ public:
     EventScheduler(EventScheduler&&) = delete;
     EventScheduler& operator=(EventScheduler&&) = delete;
 
-    /// @brief Initialize the event scheduler by preallocating space in the event queue.
+    /// @brief Initialize the event scheduler with an empty event queue.
     EventScheduler();
 
     /// @brief Register a callback function for an event. All callbacks should be registered during component initialization.
@@ -88,20 +87,29 @@ public:
     /// @param callback Function to call when event fires.
     void RegisterEvent(EventType event, Callback callback);
 
-    /// @brief Schedule an event to fire in some number of cycles.
+    /// @brief Schedule an event to fire in some number of cycles. Only one instance of each event type can be queued at a time, so
+    ///        scheduling an event that is already in the queue reschedules it.
     /// @param event Event type to schedule.
     /// @param cycles Number of cycles from now to fire event.
     void ScheduleEvent(EventType event, int cycles);
 
-    /// @brief Schedule an event with an offset cycleQueued_ value.
+    /// @brief Schedule an event with an offset cycleQueued_ value. Reschedules the event if it is already in the queue.
     /// @param event Event type to schedule.
     /// @param offset How many cycles from the current value of totalCycles_ to schedule the event.
     /// @param length Number of cycles from the relative start time that the event should fire.
     void ScheduleEvent(EventType event, int offset, u32 length);
 
     /// @brief Advance the scheduler by some number of cycles and execute any scheduled events that have occurred.
-    /// @param cycles Number of cycles to advance the scheduler by.
-    void Step(int cycles);
+    /// @param cycles Number of cycles to advance the scheduler by. Must be positive.
+    void Step(int cycles)
+    {
+        totalCycles_ += static_cast<u64>(cycles);
+
+        if (totalCycles_ >= nextEventCycle_)
+        {
+            CheckEventQueue();
+        }
+    }
 
     /// @brief Advance the scheduler to whenever the next scheduled event would occur.
     void FireNextEvent();
@@ -110,6 +118,10 @@ public:
     /// @return Total cycle count.
     u64 GetTotalElapsedCycles() const { return totalCycles_; }
 
+    /// @brief Get the cycle at which the next scheduled event will fire.
+    /// @return Cycle of next event, or U64_MAX if no events are scheduled.
+    u64 GetNextEventCycle() const { return nextEventCycle_; }
+
     /// @brief Remove an event from the current event queue.
     /// @param event Event type to be unscheduled.
     /// @return If the event was in the queue, return how many cycles it had left until it would have been fired.
@@ -120,6 +132,11 @@ public:
     /// @return If the event is currently in the queue, return the number of cycles since it was queued.
     std::optional<int> ElapsedCycles(EventType event);
 
+    /// @brief Check if an event is currently in the queue.
+    /// @param event Event type to check.
+    /// @return True if the event is scheduled to fire.
+    bool EventScheduled(EventType event) const { return heapIndex_[static_cast<size_t>(event)] != NOT_SCHEDULED; }
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Save States
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -133,13 +150,44 @@ public:
     void Deserialize(std::ifstream& saveState);
 
 private:
-    /// @brief Rearrange queue into a min heap.
-    void MakeMinHeap() { std::make_heap(queue_.begin(), queue_.end(), std::greater<>{}); }
+    static constexpr size_t EVENT_COUNT = static_cast<size_t>(EventType::COUNT);
+    static constexpr u8 NOT_SCHEDULED = U8_MAX;
+    static_assert(EVENT_COUNT < NOT_SCHEDULED, "Too many event types to track heap indices with u8");
+
+    /// @brief Add an event to the queue, or move it to its new position if it's already queued.
+    /// @param event Event to queue.
+    void Enqueue(Event event);
+
+    /// @brief Remove the event at some position in the heap.
+    /// @param index Heap index of event to remove.
+    void RemoveAt(size_t index);
+
+    /// @brief Move an event towards the root of the heap until the heap property is restored.
+    /// @param index Heap index of event to move.
+    void SiftUp(size_t index);
+
+    /// @brief Move an event towards the leaves of the heap until the heap property is restored.
+    /// @param index Heap index of event to move.
+    void SiftDown(size_t index);
+
+    /// @brief Place an event at a position in the heap and record its new index.
+    /// @param index Heap index to place event at.
+    /// @param event Event to place.
+    void Place(size_t index, Event event);
+
+    /// @brief Update the cached cycle of the next event after the head of the heap may have changed.
+    void UpdateNextEventCycle() { nextEventCycle_ = (heapSize_ > 0) ? heap_[0].cycleToExecute_ : U64_MAX; }
 
     /// @brief Execute any scheduled events which were scheduled to execute at or before the current total cycle count.
     void CheckEventQueue();
 
-    std::vector<Event> queue_;
-    std::unordered_map<EventType, Callback> callbacks_;
+    // Min heap of pending events. Since each event type can be queued at most once, the heap never holds more than EVENT_COUNT
+    // events, and the position of each event type is tracked so it can be found without searching.
+    std::array<Event, EVENT_COUNT> heap_;
+    std::array<u8, EVENT_COUNT> heapIndex_;
+    size_t heapSize_;
+
+    std::array<Callback, EVENT_COUNT> callbacks_;
     u64 totalCycles_;
+    u64 nextEventCycle_;
 };
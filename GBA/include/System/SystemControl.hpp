@@ -63,6 +63,12 @@ public:
     /// @return Number of cycles taken to write.
     int WriteReg(u32 addr, u32 val, AccessSize length);
 
+    /// @brief Read IE and/or IF without checking for unused registers.
+    /// @param addr Address of IE or IF.
+    /// @param length Memory access size of the read.
+    /// @return Number of cycles taken to read, value of the requested register(s), and whether it was an open-bus read.
+    MemReadData ReadIEAndIF(u32 addr, AccessSize length);
+
     /// @brief Set an interrupt flag in the IF register.
     /// @param interrupt Which interrupt type to request.
     void RequestInterrupt(InterruptType interrupt);
@@ -84,11 +90,14 @@ public:
     /// @param sequential Whether this access is sequential to the last one.
     /// @param length Memory access size.
     /// @return Number of additional wait states for the current read/write operation.
-    int WaitStates(WaitStateRegion region, bool sequential, AccessSize length) const;
+    int WaitStates(WaitStateRegion region, bool sequential, AccessSize length) const
+    {
+        return waitStates_[static_cast<size_t>(region)][sequential][length == AccessSize::WORD];
+    }
 
     /// @brief Check if the GamePak prefetcher is enabled.
     /// @return Whether prefetcher is currently enabled.
-    bool GamePakPrefetchEnabled() const { return GetWAITCNT().prefetchBuffer; }
+    bool GamePakPrefetchEnabled() const { return prefetchEnabled_; }
 
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Save States
@@ -194,6 +203,9 @@ private:
     /// @param reg New value of WAITCNT.
     void SetWAITCNT(WAITCNT reg) { std::memcpy(&interruptAndWaitcntRegisters_[WAITCNT::INDEX], &reg, sizeof(WAITCNT)); }
 
+    /// @brief Decode WAITCNT into the wait state table and prefetch flag. Must be called whenever WAITCNT changes.
+    void UpdateWaitStates();
+
     ///-----------------------------------------------------------------------------------------------------------------------------
     /// Data
     ///-----------------------------------------------------------------------------------------------------------------------------
@@ -206,6 +218,10 @@ private:
     std::array<std::byte, 0x04> postFlgAndHaltcntRegisters_;
     std::array<std::byte, 0x04> memoryControlRegisters_;
 
+    // Decoded WAITCNT, indexed by [region][sequential][word access]
+    std::array<std::array<std::array<u8, 2>, 2>, 4> waitStates_;
+    bool prefetchEnabled_;
+
     // External components
     EventScheduler& scheduler_;
 
@@ -39,6 +39,21 @@ public:
     /// @return Number of cycles taken to write.
     int WriteReg(u32 addr, u32 val, AccessSize length);
 
+    /// @brief Read an address mapped to a specific timer's registers, skipping the check for which timer it belongs to.
+    /// @param addr Address of timer register(s).
+    /// @param length Memory access size of the read.
+    /// @return Number of cycles taken to read, value of the requested register(s), and whether it was an open-bus read.
+    template <u8 Index>
+    MemReadData ReadTimerReg(u32 addr, AccessSize length) { return timers_[Index].ReadReg(addr, length); }
+
+    /// @brief Write to an address mapped to a specific timer's registers, skipping the check for which timer it belongs to.
+    /// @param addr Address of timer register(s).
+    /// @param val Value to write to register(s).
+    /// @param length Memory access size of the write.
+    /// @return Number of cycles taken to write.
+    template <u8 Index>
+    int WriteTimerReg(u32 addr, u32 val, AccessSize length) { return timers_[Index].WriteReg(addr, val, length); }
+
     /// @brief Handle a timer overflow event.
     /// @param index Index of timer that overflowed.
     /// @param extraCycles How many cycles have passed since the overflow event.
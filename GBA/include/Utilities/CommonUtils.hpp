@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cassert>
 #include <cstddef>
 #include <cstring>
 #include <span>
@@ -21,6 +22,69 @@ u32 ReadMemoryBlock(std::span<const std::byte> memory, u32 readAddr, u32 baseAdd
 /// @param length Memory access size of the write.
 void WriteMemoryBlock(std::span<std::byte> memory, u32 writeAddr, u32 baseAddr, u32 val, AccessSize length);
 
+/// @brief Read a byte, halfword, or word from a block of memory that the caller has already mapped the address into. Bounds are
+///        only asserted, unless built with ADVANCEDBOY_PARANOID_MEMORY in which case this is the same as ReadMemoryBlock.
+/// @param memory Span of bytes to read from.
+/// @param readAddr Address being read. This must be aligned and fall within memory.
+/// @param baseAddr Base address of block of memory being read from.
+/// @param length Memory access size of the read.
+/// @return Value at the specified location in the provided span.
+inline u32 ReadMemoryBlockUnchecked(std::span<const std::byte> memory, u32 readAddr, u32 baseAddr, AccessSize length)
+{
+#ifdef ADVANCEDBOY_PARANOID_MEMORY
+    return ReadMemoryBlock(memory, readAddr, baseAddr, length);
+#else
+    size_t index = readAddr - baseAddr;
+    assert((index + static_cast<size_t>(length)) <= memory.size());
+    u32 val = 0;
+
+    switch (length)
+    {
+        case AccessSize::BYTE:
+            std::memcpy(&val, memory.data() + index, sizeof(u8));
+            break;
+        case AccessSize::HALFWORD:
+            std::memcpy(&val, memory.data() + index, sizeof(u16));
+            break;
+        default:
+            std::memcpy(&val, memory.data() + index, sizeof(u32));
+            break;
+    }
+
+    return val;
+#endif
+}
+
+/// @brief Write a byte, halfword, or word to a block of memory that the caller has already mapped the address into. Bounds are
+///        only asserted, unless built with ADVANCEDBOY_PARANOID_MEMORY in which case this is the same as WriteMemoryBlock.
+/// @param memory Span of bytes to write into.
+/// @param writeAddr Address to write to. This must be aligned and fall within memory.
+/// @param baseAddr Base address of block of memory to write to.
+/// @param val Value to write into memory.
+/// @param length Memory access size of the write.
+inline void WriteMemoryBlockUnchecked(std::span<std::byte> memory, u32 writeAddr, u32 baseAddr, u32 val, AccessSize length)
+{
+#ifdef ADVANCEDBOY_PARANOID_MEMORY
+    WriteMemoryBlock(memory, writeAddr, baseAddr, val, length);
+#else
+    size_t index = writeAddr - baseAddr;
+    assert((index + static_cast<size_t>(length)) <= memory.size());
+
+    switch (length)
+    {
+        case AccessSize::BYTE:
+            std::memcpy(memory.data() + index, &val, sizeof(u8));
+            break;
+        case AccessSize::HALFWORD:
+            std::memcpy(memory.data() + index, &val, sizeof(u16));
+            break;
+        default:
+            std::memcpy(memory.data() + index, &val, sizeof(u32));
+            break;
+    }
+#endif
+}
+
 /// @brief Find the mirrored address for an address in a mirrored region.
 /// @param addr Out-of-bounds address in a region that implements standard memory mirroring. Must be > max.
 /// @param min Base address of the memory region.
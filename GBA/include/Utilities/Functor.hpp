@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+
 /// @brief Primary template of MemberFunctor.
 template<typename>
 class MemberFunctor;
@@ -25,4 +28,48 @@ private:
     ObjT* objectPtr_;
 };
 
+/// @brief Primary template of Delegate.
+template<typename>
+class Delegate;
+
+/// @brief Type-erased, non-allocating callback into a class member function. Unlike MemberFunctor, the type of the object being
+///        called into is not part of the Delegate type, so delegates to different classes can be stored together in one array.
+/// @tparam ReturnT Return type of callback function.
+/// @tparam ...TArgs Args to pass into callback.
+template<typename ReturnT, typename... TArgs>
+class Delegate<ReturnT(TArgs...)>
+{
+public:
+    /// @brief Create an unbound delegate. Must not be invoked until a bound delegate is assigned to it.
+    Delegate();
+
+    /// @brief Create a delegate bound to a class member function.
+    /// @tparam ObjT Class type that contains callback function.
+    /// @param memberFunctionPtr Pointer to member function to call.
+    /// @param objectRef Object to call member function on.
+    template<typename ObjT>
+    Delegate(ReturnT (ObjT::*memberFunctionPtr)(TArgs...), ObjT& objectRef);
+
+    ReturnT operator()(TArgs... params);
+
+    /// @brief Check whether this delegate has been bound to a member function.
+    /// @return True if this delegate can be invoked.
+    bool Bound() const { return invoker_ != nullptr; }
+
+private:
+    using InvokerType = ReturnT (*)(std::byte*, TArgs...);
+
+    /// @brief Call the MemberFunctor stored in a delegate's storage.
+    /// @tparam FunctorT Type of MemberFunctor in storage.
+    /// @param storage Pointer to delegate storage.
+    /// @param ...params Args to pass into callback.
+    /// @return Value returned by callback.
+    template<typename FunctorT>
+    static ReturnT Invoke(std::byte* storage, TArgs... params);
+
+    // Large enough to hold a MemberFunctor for any single-inheritance class.
+    alignas(void*) std::array<std::byte, 3 * sizeof(void*)> storage_;
+    InvokerType invoker_;
+};
+
 #include <GBA/include/Utilities/Functor.tpp>
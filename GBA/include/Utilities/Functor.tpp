@@ -1,6 +1,10 @@
 #pragma once
 
 #include <GBA/include/Utilities/Functor.hpp>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 template<typename ReturnT, typename ObjT, typename... TArgs>
@@ -15,3 +19,36 @@ ReturnT MemberFunctor<ReturnT (ObjT::*)(TArgs...)>::operator()(TArgs... params)
 {
     return (objectPtr_->*memberFunctionPtr_)(std::forward<TArgs>(params)...);
 }
+
+template<typename ReturnT, typename... TArgs>
+Delegate<ReturnT(TArgs...)>::Delegate() :
+    storage_(),
+    invoker_(nullptr)
+{
+}
+
+template<typename ReturnT, typename... TArgs>
+template<typename ObjT>
+Delegate<ReturnT(TArgs...)>::Delegate(ReturnT (ObjT::*memberFunctionPtr)(TArgs...), ObjT& objectRef) :
+    storage_(),
+    invoker_(&Invoke<MemberFunctor<ReturnT (ObjT::*)(TArgs...)>>)
+{
+    using FunctorT = MemberFunctor<ReturnT (ObjT::*)(TArgs...)>;
+    static_assert(sizeof(FunctorT) <= sizeof(storage_), "MemberFunctor does not fit in Delegate storage");
+    static_assert(alignof(FunctorT) <= alignof(void*), "MemberFunctor alignment exceeds Delegate storage alignment");
+    static_assert(std::is_trivially_copyable_v<FunctorT>, "Delegate storage is copied byte-wise");
+    std::construct_at(reinterpret_cast<FunctorT*>(storage_.data()), memberFunctionPtr, objectRef);
+}
+
+template<typename ReturnT, typename... TArgs>
+ReturnT Delegate<ReturnT(TArgs...)>::operator()(TArgs... params)
+{
+    return invoker_(storage_.data(), std::forward<TArgs>(params)...);
+}
+
+template<typename ReturnT, typename... TArgs>
+template<typename FunctorT>
+ReturnT Delegate<ReturnT(TArgs...)>::Invoke(std::byte* storage, TArgs... params)
+{
+    return (*std::launder(reinterpret_cast<FunctorT*>(storage)))(std::forward<TArgs>(params)...);
+}
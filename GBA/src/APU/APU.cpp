@@ -29,7 +29,7 @@ APU::APU(ClockManager const& clockMgr, EventScheduler& scheduler) :
 {
     registers_.fill(std::byte{0});
 
-    scheduler_.RegisterEvent(EventType::SampleAPU, [this](int extraCycles){ this->Sample(extraCycles); });
+    scheduler_.RegisterEvent(EventType::SampleAPU, {&APU::Sample, *this});
     scheduler.ScheduleEvent(EventType::SampleAPU, clockMgr_.GetCpuCyclesPerSample());
 }
 
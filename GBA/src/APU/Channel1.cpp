@@ -23,10 +23,10 @@ Channel1::Channel1(ClockManager const& clockMgr, EventScheduler& scheduler) : cl
     lengthTimerExpired_ = false;
     frequencyOverflow_ = false;
 
-    scheduler_.RegisterEvent(EventType::Channel1Clock, [this](int c){ this->Clock(c); });
-    scheduler_.RegisterEvent(EventType::Channel1Envelope, [this](int extraCycles){ this->Envelope(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel1LengthTimer, [this](int extraCycles){ this->LengthTimer(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel1FrequencySweep, [this](int extraCycles){ this->FrequencySweep(extraCycles); });
+    scheduler_.RegisterEvent(EventType::Channel1Clock, {&Channel1::Clock, *this});
+    scheduler_.RegisterEvent(EventType::Channel1Envelope, {&Channel1::Envelope, *this});
+    scheduler_.RegisterEvent(EventType::Channel1LengthTimer, {&Channel1::LengthTimer, *this});
+    scheduler_.RegisterEvent(EventType::Channel1FrequencySweep, {&Channel1::FrequencySweep, *this});
 }
 
 std::pair<u32, bool> Channel1::ReadReg(u32 addr, AccessSize length)
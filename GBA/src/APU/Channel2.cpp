@@ -22,9 +22,9 @@ Channel2::Channel2(ClockManager const& clockMgr, EventScheduler& scheduler) : cl
     dutyCycleIndex_ = 0;
     lengthTimerExpired_ = false;
 
-    scheduler_.RegisterEvent(EventType::Channel2Clock, [this](int extraCycles){ this->Clock(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel2Envelope, [this](int extraCycles){ this->Envelope(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel2LengthTimer, [this](int extraCycles){ this->LengthTimer(extraCycles); });
+    scheduler_.RegisterEvent(EventType::Channel2Clock, {&Channel2::Clock, *this});
+    scheduler_.RegisterEvent(EventType::Channel2Envelope, {&Channel2::Envelope, *this});
+    scheduler_.RegisterEvent(EventType::Channel2LengthTimer, {&Channel2::LengthTimer, *this});
 }
 
 std::pair<u32, bool> Channel2::ReadReg(u32 addr, AccessSize length)
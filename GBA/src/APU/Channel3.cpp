@@ -21,8 +21,8 @@ Channel3::Channel3(ClockManager const& clockMgr, EventScheduler& scheduler) : cl
     playbackMask_ = 0xF0;
     playbackBank_ = 0;
 
-    scheduler_.RegisterEvent(EventType::Channel3Clock, [this](int extraCycles){ this->Clock(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel3LengthTimer, [this](int extraCycles){ this->LengthTimer(extraCycles); });
+    scheduler_.RegisterEvent(EventType::Channel3Clock, {&Channel3::Clock, *this});
+    scheduler_.RegisterEvent(EventType::Channel3LengthTimer, {&Channel3::LengthTimer, *this});
 }
 
 std::pair<u32, bool> Channel3::ReadReg(u32 addr, AccessSize length)
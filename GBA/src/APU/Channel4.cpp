@@ -22,9 +22,9 @@ Channel4::Channel4(ClockManager const& clockMgr, EventScheduler& scheduler) : cl
     currentVolume_ = 0;
     lengthTimerExpired_ = false;
 
-    scheduler_.RegisterEvent(EventType::Channel4Clock, [this](int extraCycles){ this->Clock(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel4Envelope, [this](int extraCycles){ this->Envelope(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Channel4LengthTimer, [this](int extraCycles){ this->LengthTimer(extraCycles); });
+    scheduler_.RegisterEvent(EventType::Channel4Clock, {&Channel4::Clock, *this});
+    scheduler_.RegisterEvent(EventType::Channel4Envelope, {&Channel4::Envelope, *this});
+    scheduler_.RegisterEvent(EventType::Channel4LengthTimer, {&Channel4::LengthTimer, *this});
 }
 
 std::pair<u32, bool> Channel4::ReadReg(u32 addr, AccessSize length)
@@ -1,17 +1,49 @@
 #include <GBA/include/BIOS/BIOSManager.hpp>
+#include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <utility>
 #include <GBA/include/Memory/MemoryMap.hpp>
 #include <GBA/include/Utilities/CommonUtils.hpp>
 #include <GBA/include/Utilities/Functor.hpp>
 #include <GBA/include/Utilities/Types.hpp>
 
+namespace
+{
+/// @brief Address and encoding of each ARM instruction in the built-in BIOS. The IRQ handler is the same code at the same address
+///        as in the official BIOS so that games see the same open bus values after an interrupt.
+constexpr std::array<std::pair<u32, u32>, 14> BUILT_IN_BIOS = {{
+    {0x0000, 0xE3A0'F302},  // Reset:           mov pc, #0x08000000
+    {0x0004, 0xE1B0'F00E},  // Undefined:       movs pc, lr
+    {0x0008, 0xE1B0'F00E},  // SWI:             movs pc, lr
+    {0x000C, 0xE25E'F004},  // Prefetch abort:  subs pc, lr, #4
+    {0x0010, 0xE25E'F008},  // Data abort:      subs pc, lr, #8
+    {0x0014, 0xE25E'F004},  // Reserved:        subs pc, lr, #4
+    {0x0018, 0xEA00'0042},  // IRQ:             b 0x128
+    {0x001C, 0xE25E'F004},  // FIQ:             subs pc, lr, #4
+    {0x0128, 0xE92D'500F},  //                  stmfd sp!, {r0-r3, r12, lr}
+    {0x012C, 0xE3A0'0301},  //                  mov r0, #0x04000000
+    {0x0130, 0xE28F'E000},  //                  add lr, pc, #0
+    {0x0134, 0xE510'F004},  //                  ldr pc, [r0, #-4]
+    {0x0138, 0xE8BD'500F},  //                  ldmfd sp!, {r0-r3, r12, lr}
+    {0x013C, 0xE25E'F004},  //                  subs pc, lr, #4
+}};
+}
+
 BIOSManager::BIOSManager(fs::path biosPath, GetPCCallback getPC) : GetPC(getPC)
 {
     lastSuccessfulFetch_ = 0;
     biosLoaded_ = false;
+    builtInBios_ = false;
+
+    if (biosPath.empty())
+    {
+        LoadBuiltInBios();
+        return;
+    }
 
-    if (biosPath.empty() || !fs::exists(biosPath) || !fs::is_regular_file(biosPath))
+    if (!fs::exists(biosPath) || !fs::is_regular_file(biosPath))
     {
         return;
     }
@@ -48,10 +80,23 @@ MemReadData BIOSManager::ReadMem(u32 addr, AccessSize length)
         return {cycles, lastSuccessfulFetch_, false};
     }
 
-    lastSuccessfulFetch_ = ReadMemoryBlock(biosROM_, addr, BIOS_ADDR_MIN, length);
+    lastSuccessfulFetch_ = ReadMemoryBlockUnchecked(biosROM_, addr, BIOS_ADDR_MIN, length);
     return {cycles, lastSuccessfulFetch_, false};
 }
 
+void BIOSManager::LoadBuiltInBios()
+{
+    biosROM_.fill(std::byte{0});
+
+    for (auto [addr, instruction] : BUILT_IN_BIOS)
+    {
+        std::memcpy(&biosROM_[addr], &instruction, sizeof(instruction));
+    }
+
+    biosLoaded_ = true;
+    builtInBios_ = true;
+}
+
 void BIOSManager::Serialize(std::ofstream& saveState) const
 {
     SerializeTrivialType(lastSuccessfulFetch_);
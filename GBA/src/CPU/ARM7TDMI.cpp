@@ -17,14 +17,27 @@
 
 namespace cpu
 {
-ARM7TDMI::ARM7TDMI(ReadMemCallback readMem,
-                   WriteMemCallback writeMem,
+ARM7TDMI::ARM7TDMI(BusCallbacks bus,
+                   ReadMemCallback fetchMem,
+                   BackwardBranchCallback backwardBranch,
+                   ProtectCodeCallback protectCode,
                    EventScheduler& scheduler,
                    bool skipBiosIntro) :
-    ReadMemory(readMem),
-    WriteMemory(writeMem),
+    bus_(bus),
+    FetchMemory(fetchMem),
+    BackwardBranch(backwardBranch),
     registers_(skipBiosIntro),
     flushPipeline_(false),
+    backend_(CpuBackend::Interpreter),
+    ProtectCode(protectCode),
+    currentBlock_(nullptr),
+    currentBlockNextPC_(0),
+    currentBlockArm_(true),
+    currentBlockIndex_(0),
+    uncachedInstructions_(0),
+    hleBios_(false),
+    hleIntrWaitRetry_(false),
+    builtInBios_(false),
     scheduler_(scheduler)
 {
 }
@@ -41,16 +54,22 @@ bool ARM7TDMI::Step(bool irq)
 
     // Fetch
     u32 fetchedPC = registers_.GetPC();
-    auto [fetchedInstruction, cycles] = ReadMemory(fetchedPC, length);
+    auto [fetchedInstruction, cycles] = FetchMemory(fetchedPC, length);
     pipeline_.Push({fetchedInstruction, fetchedPC});
     scheduler_.Step(cycles);
 
     // Decode and execute
+    bool shortBackwardBranch = false;
+
     if (pipeline_.Full())
     {
         auto [undecodedInstruction, executedPC] = pipeline_.Pop();
 
-        if (armState)
+        if (backend_ == CpuBackend::CachedDecode)
+        {
+            ExecuteCached(undecodedInstruction, executedPC, armState);
+        }
+        else if (armState)
         {
             DecodeAndExecuteARM(undecodedInstruction);
         }
@@ -58,12 +77,20 @@ bool ARM7TDMI::Step(bool irq)
         {
             DecodeAndExecuteTHUMB(undecodedInstruction);
         }
+
+        shortBackwardBranch =
+            flushPipeline_ && ((executedPC - registers_.GetPC()) < (MAX_IDLE_LOOP_INSTRUCTIONS * static_cast<u32>(length)));
     }
 
     if (flushPipeline_)
     {
         pipeline_.Clear();
         flushPipeline_ = false;
+
+        if (shortBackwardBranch)
+        {
+            BackwardBranch();
+        }
     }
     else
     {
@@ -88,6 +115,7 @@ void ARM7TDMI::Serialize(std::ofstream& saveState) const
     registers_.Serialize(saveState);
     pipeline_.Serialize(saveState);
     SerializeTrivialType(flushPipeline_);
+    SerializeTrivialType(hleIntrWaitRetry_);
 }
 
 void ARM7TDMI::Deserialize(std::ifstream& saveState)
@@ -95,6 +123,8 @@ void ARM7TDMI::Deserialize(std::ifstream& saveState)
     registers_.Deserialize(saveState);
     pipeline_.Deserialize(saveState);
     DeserializeTrivialType(flushPipeline_);
+    DeserializeTrivialType(hleIntrWaitRetry_);
+    ClearDecodedBlocks();
 }
 
 void ARM7TDMI::HandleIRQ()
@@ -1,4 +1,5 @@
 #include <GBA/include/CPU/ARM7TDMI.hpp>
+#include <array>
 #include <bit>
 #include <cstring>
 #include <stdexcept>
@@ -79,6 +80,89 @@ namespace cpu
 {
 using namespace arm;
 
+constexpr std::array<ARM7TDMI::ArmHandler, 512> ARM7TDMI::GenerateDataProcessingTable()
+{
+    // Index bits: [8] I, [7:4] OpCode, [3] S, [2:1] ShiftType, [0] RegShift. Shift fields are part of the immediate when I is
+    // set, so all of those indices share a single specialization.
+    return []<u32... Index>(std::integer_sequence<u32, Index...>)
+    {
+        return std::array<ArmHandler, 512>{
+            &ARM7TDMI::ExecuteDataProcessing<(Index >> 4) & 0x0F,
+                                             (Index & 0x08) != 0,
+                                             (Index & 0x100) != 0,
+                                             (Index & 0x100) ? 0 : ((Index >> 1) & 0x03),
+                                             ((Index & 0x100) == 0) && ((Index & 0x01) != 0)>...
+        };
+    }(std::make_integer_sequence<u32, 512>{});
+}
+
+constexpr std::array<ARM7TDMI::ArmHandler, 4096> ARM7TDMI::GenerateArmDecodeTable()
+{
+    struct ArmFormat
+    {
+        u32 format;
+        u32 formatMask;
+        ArmHandler handler;
+    };
+
+    // Same priority order as DecodeAndExecuteARMByFormat. Data processing handlers are looked up separately since they're
+    // specialized on fields within the index.
+    constexpr std::array<ArmFormat, 14> formats = {{
+        {BranchAndExchange::FORMAT, BranchAndExchange::FORMAT_MASK, &ARM7TDMI::ExecuteBranchAndExchange},
+        {BlockDataTransfer::FORMAT, BlockDataTransfer::FORMAT_MASK, &ARM7TDMI::ExecuteBlockDataTransfer},
+        {Branch::FORMAT, Branch::FORMAT_MASK, &ARM7TDMI::ExecuteBranch},
+        {SoftwareInterrupt::FORMAT, SoftwareInterrupt::FORMAT_MASK, &ARM7TDMI::ExecuteArmSoftwareInterrupt},
+        {Undefined::FORMAT, Undefined::FORMAT_MASK, &ARM7TDMI::ExecuteUndefined},
+        {SingleDataTransfer::FORMAT, SingleDataTransfer::FORMAT_MASK, &ARM7TDMI::ExecuteSingleDataTransfer},
+        {SingleDataSwap::FORMAT, SingleDataSwap::FORMAT_MASK, &ARM7TDMI::ExecuteSingleDataSwap},
+        {Multiply::FORMAT, Multiply::FORMAT_MASK, &ARM7TDMI::ExecuteMultiply},
+        {MultiplyLong::FORMAT, MultiplyLong::FORMAT_MASK, &ARM7TDMI::ExecuteMultiplyLong},
+        {HalfwordDataTransferRegOffset::FORMAT, HalfwordDataTransferRegOffset::FORMAT_MASK, &ARM7TDMI::ExecuteHalfwordDataTransfer},
+        {HalfwordDataTransferImmOffset::FORMAT, HalfwordDataTransferImmOffset::FORMAT_MASK, &ARM7TDMI::ExecuteHalfwordDataTransfer},
+        {PSRTransferMRS::FORMAT, PSRTransferMRS::FORMAT_MASK, &ARM7TDMI::ExecutePSRTransferMRS},
+        {PSRTransferMSR::FORMAT, PSRTransferMSR::FORMAT_MASK, &ARM7TDMI::ExecutePSRTransferMSR},
+        {DataProcessing::FORMAT, DataProcessing::FORMAT_MASK, nullptr},
+    }};
+
+    constexpr std::array<ArmHandler, 512> dataProcessingTable = GenerateDataProcessingTable();
+    constexpr u32 indexMask = 0x0FF0'00F0;
+    std::array<ArmHandler, 4096> table = {};
+
+    for (u32 index = 0; index < table.size(); ++index)
+    {
+        u32 instruction = ((index & 0x0FF0) << 16) | ((index & 0x0F) << 4);
+        ArmHandler handler = &ARM7TDMI::DecodeAndExecuteARMByFormat;
+
+        for (auto const& [format, formatMask, formatHandler] : formats)
+        {
+            if ((instruction & formatMask & indexMask) != (format & indexMask))
+            {
+                continue;
+            }
+
+            // A format that also checks bits outside of the index might or might not match depending on the rest of the
+            // instruction, so the full format checks have to run at execution time.
+            if ((formatMask & ~indexMask & 0x0FFF'FFFF) == 0)
+            {
+                if (formatHandler == nullptr)
+                {
+                    handler = dataProcessingTable[DataProcessingIndex(instruction)];
+                }
+                else
+                {
+                    handler = formatHandler;
+                }
+            }
+
+            break;
+        }
+
+        table[index] = handler;
+    }
+
+    return table;
+}
+
 void ARM7TDMI::DecodeAndExecuteARM(u32 instruction)
 {
     u8 conditionCode = (instruction & 0xF000'0000) >> 28;
@@ -89,66 +173,94 @@ void ARM7TDMI::DecodeAndExecuteARM(u32 instruction)
         return;
     }
 
+    (this->*LookupArmHandler(instruction))(instruction);
+}
+
+ARM7TDMI::ArmHandler ARM7TDMI::LookupArmHandler(u32 instruction)
+{
+    static constexpr std::array<ArmHandler, 4096> ARM_DECODE_TABLE = GenerateArmDecodeTable();
+    u32 index = ((instruction & 0x0FF0'0000) >> 16) | ((instruction & 0x0000'00F0) >> 4);
+    return ARM_DECODE_TABLE[index];
+}
+
+ARM7TDMI::ArmHandler ARM7TDMI::DecodeArm(u32 instruction)
+{
+    ArmHandler handler = LookupArmHandler(instruction);
+    return (handler == &ARM7TDMI::DecodeAndExecuteARMByFormat) ? DecodeArmByFormat(instruction) : handler;
+}
+
+void ARM7TDMI::DecodeAndExecuteARMByFormat(u32 instruction)
+{
+    (this->*DecodeArmByFormat(instruction))(instruction);
+}
+
+ARM7TDMI::ArmHandler ARM7TDMI::DecodeArmByFormat(u32 instruction)
+{
     if (BranchAndExchange::IsInstanceOf(instruction))
     {
-        ExecuteBranchAndExchange(instruction);
+        return &ARM7TDMI::ExecuteBranchAndExchange;
     }
     else if (BlockDataTransfer::IsInstanceOf(instruction))
     {
-        ExecuteBlockDataTransfer(instruction);
+        return &ARM7TDMI::ExecuteBlockDataTransfer;
     }
     else if (Branch::IsInstanceOf(instruction))
     {
-        ExecuteBranch(instruction);
+        return &ARM7TDMI::ExecuteBranch;
     }
     else if (SoftwareInterrupt::IsInstanceOf(instruction))
     {
-        ExecuteArmSoftwareInterrupt(instruction);
+        return &ARM7TDMI::ExecuteArmSoftwareInterrupt;
     }
     else if (Undefined::IsInstanceOf(instruction))
     {
-        ExecuteUndefined(instruction);
+        return &ARM7TDMI::ExecuteUndefined;
     }
     else if (SingleDataTransfer::IsInstanceOf(instruction))
     {
-        ExecuteSingleDataTransfer(instruction);
+        return &ARM7TDMI::ExecuteSingleDataTransfer;
     }
     else if (SingleDataSwap::IsInstanceOf(instruction))
     {
-        ExecuteSingleDataSwap(instruction);
+        return &ARM7TDMI::ExecuteSingleDataSwap;
     }
     else if (Multiply::IsInstanceOf(instruction))
     {
-        ExecuteMultiply(instruction);
+        return &ARM7TDMI::ExecuteMultiply;
     }
     else if (MultiplyLong::IsInstanceOf(instruction))
     {
-        ExecuteMultiplyLong(instruction);
+        return &ARM7TDMI::ExecuteMultiplyLong;
     }
     else if (HalfwordDataTransferRegOffset::IsInstanceOf(instruction))
     {
-        ExecuteHalfwordDataTransfer(instruction);
+        return &ARM7TDMI::ExecuteHalfwordDataTransfer;
     }
     else if (HalfwordDataTransferImmOffset::IsInstanceOf(instruction))
     {
-        ExecuteHalfwordDataTransfer(instruction);
+        return &ARM7TDMI::ExecuteHalfwordDataTransfer;
     }
     else if (PSRTransferMRS::IsInstanceOf(instruction))
     {
-        ExecutePSRTransferMRS(instruction);
+        return &ARM7TDMI::ExecutePSRTransferMRS;
     }
     else if (PSRTransferMSR::IsInstanceOf(instruction))
     {
-        ExecutePSRTransferMSR(instruction);
+        return &ARM7TDMI::ExecutePSRTransferMSR;
     }
     else if (DataProcessing::IsInstanceOf(instruction))
     {
-        ExecuteDataProcessing(instruction);
-    }
-    else
-    {
-        throw std::runtime_error("Unable to decode ARM instruction");
+        static constexpr std::array<ArmHandler, 512> DATA_PROCESSING_TABLE = GenerateDataProcessingTable();
+        return DATA_PROCESSING_TABLE[DataProcessingIndex(instruction)];
     }
+
+    return &ARM7TDMI::ExecuteUndecodableArm;
+}
+
+void ARM7TDMI::ExecuteUndecodableArm(u32 instruction)
+{
+    (void)instruction;
+    throw std::runtime_error("Unable to decode ARM instruction");
 }
 
 void ARM7TDMI::ExecuteBranchAndExchange(u32 instruction)
@@ -245,7 +357,7 @@ void ARM7TDMI::ExecuteBlockDataTransfer(u32 instruction)
         {
             if (flags.L)
             {
-                auto [readValue, readCycles] = ReadMemory(addr, AccessSize::WORD);
+                auto [readValue, readCycles] = ReadMemory<AccessSize::WORD>(addr);
                 scheduler_.Step(readCycles);
 
                 if (regIndex == PC_INDEX)
@@ -273,7 +385,7 @@ void ARM7TDMI::ExecuteBlockDataTransfer(u32 instruction)
                     regValue = wbAddr;
                 }
 
-                int writeCycles = WriteMemory(addr, regValue, AccessSize::WORD);
+                int writeCycles = WriteMemory<AccessSize::WORD>(addr, regValue);
                 scheduler_.Step(writeCycles);
             }
 
@@ -311,7 +423,11 @@ void ARM7TDMI::ExecuteBranch(u32 instruction)
 
 void ARM7TDMI::ExecuteArmSoftwareInterrupt(u32 instruction)
 {
-    (void)instruction;
+    if (hleBios_ && ExecuteHleBiosFunction((instruction >> 16) & U8_MAX, registers_.GetPC() - 8))
+    {
+        return;
+    }
+
     u32 cpsr = registers_.GetCPSR();
     registers_.SetOperatingMode(OperatingMode::Supervisor);
     registers_.WriteRegister(LR_INDEX, registers_.GetPC() - 4);
@@ -404,7 +520,7 @@ void ARM7TDMI::ExecuteSingleDataTransfer(u32 instruction)
 
     if (flags.L)
     {
-        auto [val, readCycles] = ReadMemory(addr, length);
+        auto [val, readCycles] = flags.B ? ReadMemory<AccessSize::BYTE>(addr) : ReadMemory<AccessSize::WORD>(addr);
         scheduler_.Step(readCycles);
 
         if ((length == AccessSize::WORD) && ((addr & 0x03)))
@@ -425,7 +541,7 @@ void ARM7TDMI::ExecuteSingleDataTransfer(u32 instruction)
             val += 4;
         }
 
-        int writeCycles = WriteMemory(addr, val, length);
+        int writeCycles = flags.B ? WriteMemory<AccessSize::BYTE>(addr, val) : WriteMemory<AccessSize::WORD>(addr, val);
         scheduler_.Step(writeCycles);
     }
 
@@ -451,7 +567,7 @@ void ARM7TDMI::ExecuteSingleDataSwap(u32 instruction)
     u32 addr = registers_.ReadRegister(flags.Rn);
     auto length = flags.B ? AccessSize::BYTE : AccessSize::WORD;
 
-    auto [memValue, readCycles] = ReadMemory(addr, length);
+    auto [memValue, readCycles] = flags.B ? ReadMemory<AccessSize::BYTE>(addr) : ReadMemory<AccessSize::WORD>(addr);
     u32 regValue = registers_.ReadRegister(flags.Rm);
 
     if ((length == AccessSize::WORD) && (addr & 0x03))
@@ -459,7 +575,7 @@ void ARM7TDMI::ExecuteSingleDataSwap(u32 instruction)
         memValue = std::rotr(memValue, (addr & 0x03) * 8);
     }
 
-    int writeCycles = WriteMemory(addr, regValue, length);
+    int writeCycles = flags.B ? WriteMemory<AccessSize::BYTE>(addr, regValue) : WriteMemory<AccessSize::WORD>(addr, regValue);
     registers_.WriteRegister(flags.Rd, memValue);
 
     scheduler_.Step(readCycles + writeCycles);
@@ -665,14 +781,14 @@ void ARM7TDMI::ExecuteHalfwordDataTransfer(u32 instruction)
             if (h)
             {
                 // S = 1, H = 1
-                auto [halfword, readCycles] = ReadMemory(addr, AccessSize::HALFWORD);
+                auto [halfword, readCycles] = ReadMemory<AccessSize::HALFWORD>(addr);
                 scheduler_.Step(readCycles);
                 val = SignExtend<i32, 15>(halfword);
             }
             else
             {
                 // S = 1, H = 0
-                auto [byte, readCycles] = ReadMemory(addr, AccessSize::BYTE);
+                auto [byte, readCycles] = ReadMemory<AccessSize::BYTE>(addr);
                 scheduler_.Step(readCycles);
                 val = SignExtend<i32, 7>(byte);
             }
@@ -682,7 +798,7 @@ void ARM7TDMI::ExecuteHalfwordDataTransfer(u32 instruction)
         else
         {
             // S = 0, H = 1
-            auto [halfword, readCycles] = ReadMemory(addr, AccessSize::HALFWORD);
+            auto [halfword, readCycles] = ReadMemory<AccessSize::HALFWORD>(addr);
             scheduler_.Step(readCycles);
 
             if (misaligned)
@@ -703,7 +819,7 @@ void ARM7TDMI::ExecuteHalfwordDataTransfer(u32 instruction)
             halfword += 4;
         }
 
-        int writeCycles = WriteMemory(addr, halfword, AccessSize::HALFWORD);
+        int writeCycles = WriteMemory<AccessSize::HALFWORD>(addr, halfword);
         scheduler_.Step(writeCycles);
     }
 
@@ -778,6 +894,7 @@ void ARM7TDMI::ExecutePSRTransferMSR(u32 instruction)
     }
 }
 
+template <u8 OpCode, bool SetFlags, bool ImmOperand, u8 ShiftType, bool RegShift>
 void ARM7TDMI::ExecuteDataProcessing(u32 instruction)
 {
     auto flags = std::bit_cast<DataProcessing::Flags>(instruction);
@@ -787,7 +904,7 @@ void ARM7TDMI::ExecuteDataProcessing(u32 instruction)
     bool carry = registers_.IsCarry();
     bool overflow = registers_.IsOverflow();
 
-    if (flags.I)
+    if constexpr (ImmOperand)
     {
         // Rotated immediate value
         auto op2SrcFlags = std::bit_cast<DataProcessing::RotatedImmSrc>(instruction);
@@ -799,15 +916,13 @@ void ARM7TDMI::ExecuteDataProcessing(u32 instruction)
     else
     {
         // Shifted register value
-        u8 shiftType;
         u8 shiftAmount;
 
-        if (flags.RegShift)
+        if constexpr (RegShift)
         {
             // Register shifted by register
             auto op2SrcFlags = std::bit_cast<DataProcessing::RegShiftedRegSrc>(instruction);
             op2 = registers_.ReadRegister(op2SrcFlags.Rm);
-            shiftType = op2SrcFlags.ShiftOp;
             shiftAmount = registers_.ReadRegister(op2SrcFlags.Rs) & U8_MAX;
 
             if (flags.Rn == PC_INDEX)
@@ -827,170 +942,139 @@ void ARM7TDMI::ExecuteDataProcessing(u32 instruction)
             // Register shifted by immediate
             auto op2SrcFlags = std::bit_cast<DataProcessing::ImmShiftedRegSrc>(instruction);
             op2 = registers_.ReadRegister(op2SrcFlags.Rm);
-            shiftType = op2SrcFlags.ShiftOp;
             shiftAmount = op2SrcFlags.Imm;
         }
 
-        switch (shiftType)
+        if constexpr (ShiftType == 0b00)  // LSL
         {
-            case 0b00:  // LSL
+            if (shiftAmount >= 32)
             {
-                if (shiftAmount >= 32)
-                {
-                    carry = (shiftAmount == 32) ? (op2 & 0x01) : false;
-                    op2 = 0;
-                }
-                else if (shiftAmount != 0)
-                {
-                    carry = op2 & (U32_MSB >> (shiftAmount - 1));
-                    op2 <<= shiftAmount;
-                }
-
-                break;
+                carry = (shiftAmount == 32) ? (op2 & 0x01) : false;
+                op2 = 0;
             }
-            case 0b01:  // LSR
+            else if (shiftAmount != 0)
             {
-                if (shiftAmount >= 32)
-                {
-                    carry = (shiftAmount == 32) ? (op2 & U32_MSB) : false;
-                    op2 = 0;
-                }
-                else if (shiftAmount != 0)
-                {
-                    carry = op2 & (0x01 << (shiftAmount - 1));
-                    op2 >>= shiftAmount;
-                }
-                else if (!flags.RegShift)
-                {
-                    carry = op2 & U32_MSB;
-                    op2 = 0;
-                }
-
-                break;
+                carry = op2 & (U32_MSB >> (shiftAmount - 1));
+                op2 <<= shiftAmount;
             }
-            case 0b10:  // ASR
+        }
+        else if constexpr (ShiftType == 0b01)  // LSR
+        {
+            if (shiftAmount >= 32)
             {
-                bool msbSet = op2 & U32_MSB;
-
-                if (shiftAmount >= 32)
-                {
-                    carry = msbSet;
-                    op2 = msbSet ? U32_MAX : 0;
-                }
-                else if (shiftAmount != 0)
-                {
-                    carry = op2 & (0x01 << (shiftAmount - 1));
-
-                    for (u8 i = 0; i < shiftAmount; ++i)
-                    {
-                        op2 >>= 1;
-                        op2 |= (msbSet ? U32_MSB : 0);
-                    }
-                }
-                else if (!flags.RegShift)
-                {
-                    carry = msbSet;
-                    op2 = msbSet ? U32_MAX : 0;
-                }
+                carry = (shiftAmount == 32) ? (op2 & U32_MSB) : false;
+                op2 = 0;
+            }
+            else if (shiftAmount != 0)
+            {
+                carry = op2 & (0x01 << (shiftAmount - 1));
+                op2 >>= shiftAmount;
+            }
+            else if (!RegShift)
+            {
+                carry = op2 & U32_MSB;
+                op2 = 0;
+            }
+        }
+        else if constexpr (ShiftType == 0b10)  // ASR
+        {
+            bool msbSet = op2 & U32_MSB;
 
-                break;
+            if (shiftAmount >= 32)
+            {
+                carry = msbSet;
+                op2 = msbSet ? U32_MAX : 0;
             }
-            case 0b11:  // ROR, RRX
+            else if (shiftAmount != 0)
             {
-                if (shiftAmount > 32)
-                {
-                    shiftAmount %= 32;
-                }
+                carry = op2 & (0x01 << (shiftAmount - 1));
+                op2 = static_cast<u32>(static_cast<i32>(op2) >> shiftAmount);
+            }
+            else if (!RegShift)
+            {
+                carry = msbSet;
+                op2 = msbSet ? U32_MAX : 0;
+            }
+        }
+        else  // ROR, RRX
+        {
+            if (shiftAmount > 32)
+            {
+                shiftAmount %= 32;
+            }
 
-                if (shiftAmount == 0)
-                {
-                    if (!flags.RegShift)
-                    {
-                        carry = op2 & 0x01;
-                        op2 >>= 1;
-                        op2 |= (registers_.IsCarry() ? U32_MSB : 0);
-                    }
-                }
-                else
+            if (shiftAmount == 0)
+            {
+                if (!RegShift)
                 {
-                    carry = op2 & (0x01 << (shiftAmount - 1));
-                    op2 = std::rotr(op2, shiftAmount);
+                    carry = op2 & 0x01;
+                    op2 >>= 1;
+                    op2 |= (registers_.IsCarry() ? U32_MSB : 0);
                 }
-
-                break;
+            }
+            else
+            {
+                carry = op2 & (0x01 << (shiftAmount - 1));
+                op2 = std::rotr(op2, shiftAmount);
             }
         }
     }
 
     u32 result;
-    bool saveResult = true;
-    bool updateOverflowFlag = true;
+    constexpr bool logical = (OpCode == 0b0000) || (OpCode == 0b0001) || ((OpCode & 0b1100) == 0b1100) ||
+                             (OpCode == 0b1000) || (OpCode == 0b1001);
+    constexpr bool saveResult = (OpCode & 0b1100) != 0b1000;
 
-    switch (flags.OpCode)
+    if constexpr ((OpCode == 0b0000) || (OpCode == 0b1000))  // AND, TST
     {
-        case 0b0000:  // AND
-            result = op1 & op2;
-            updateOverflowFlag = false;
-            break;
-        case 0b0001:  // EOR
-            result = op1 ^ op2;
-            updateOverflowFlag = false;
-            break;
-        case 0b0010:  // SUB
-            std::tie(carry, overflow) = Sub32(op1, op2, result);
-            break;
-        case 0b0011:  // RSB
-            std::tie(carry, overflow) = Sub32(op2, op1, result);
-            break;
-        case 0b0100:  // ADD
-            std::tie(carry, overflow) = Add32(op1, op2, result);
-            break;
-        case 0b0101:  // ADC
-            std::tie(carry, overflow) = Add32(op1, op2, result, registers_.IsCarry());
-            break;
-        case 0b0110:  // SBC
-            std::tie(carry, overflow) = Sub32(op1, op2, result, true, registers_.IsCarry());
-            break;
-        case 0b0111:  // RSC
-            std::tie(carry, overflow) = Sub32(op2, op1, result, true, registers_.IsCarry());
-            break;
-        case 0b1000:  // TST
-            result = op1 & op2;
-            updateOverflowFlag = false;
-            saveResult = false;
-            break;
-        case 0b1001:  // TEQ
-            result = op1 ^ op2;
-            updateOverflowFlag = false;
-            saveResult = false;
-            break;
-        case 0b1010:  // CMP
-            std::tie(carry, overflow) = Sub32(op1, op2, result);
-            saveResult = false;
-            break;
-        case 0b1011:  // CMN
-            std::tie(carry, overflow) = Add32(op1, op2, result);
-            saveResult = false;
-            break;
-        case 0b1100:  // ORR
-            result = op1 | op2;
-            updateOverflowFlag = false;
-            break;
-        case 0b1101:  // MOV
-            result = op2;
-            updateOverflowFlag = false;
-            break;
-        case 0b1110:  // BIC
-            result = op1 & ~op2;
-            updateOverflowFlag = false;
-            break;
-        case 0b1111:  // MVN
-            result = ~op2;
-            updateOverflowFlag = false;
-            break;
+        result = op1 & op2;
+    }
+    else if constexpr ((OpCode == 0b0001) || (OpCode == 0b1001))  // EOR, TEQ
+    {
+        result = op1 ^ op2;
+    }
+    else if constexpr ((OpCode == 0b0010) || (OpCode == 0b1010))  // SUB, CMP
+    {
+        std::tie(carry, overflow) = Sub32(op1, op2, result);
+    }
+    else if constexpr (OpCode == 0b0011)  // RSB
+    {
+        std::tie(carry, overflow) = Sub32(op2, op1, result);
+    }
+    else if constexpr ((OpCode == 0b0100) || (OpCode == 0b1011))  // ADD, CMN
+    {
+        std::tie(carry, overflow) = Add32(op1, op2, result);
+    }
+    else if constexpr (OpCode == 0b0101)  // ADC
+    {
+        std::tie(carry, overflow) = Add32(op1, op2, result, registers_.IsCarry());
+    }
+    else if constexpr (OpCode == 0b0110)  // SBC
+    {
+        std::tie(carry, overflow) = Sub32(op1, op2, result, true, registers_.IsCarry());
+    }
+    else if constexpr (OpCode == 0b0111)  // RSC
+    {
+        std::tie(carry, overflow) = Sub32(op2, op1, result, true, registers_.IsCarry());
+    }
+    else if constexpr (OpCode == 0b1100)  // ORR
+    {
+        result = op1 | op2;
+    }
+    else if constexpr (OpCode == 0b1101)  // MOV
+    {
+        result = op2;
+    }
+    else if constexpr (OpCode == 0b1110)  // BIC
+    {
+        result = op1 & ~op2;
+    }
+    else  // MVN
+    {
+        result = ~op2;
     }
 
-    if (flags.S)
+    if constexpr (SetFlags)
     {
         if (flags.Rd == PC_INDEX)
         {
@@ -1003,16 +1087,16 @@ void ARM7TDMI::ExecuteDataProcessing(u32 instruction)
             registers_.SetZero(result == 0);
             registers_.SetCarry(carry);
 
-            if (updateOverflowFlag)
+            if constexpr (!logical)
             {
                 registers_.SetOverflow(overflow);
             }
         }
     }
 
-    if (saveResult)
+    if constexpr (saveResult)
     {
-        if (!flags.S && (flags.Rd == PC_INDEX))
+        if (!SetFlags && (flags.Rd == PC_INDEX))
         {
             flushPipeline_ = true;
         }
@@ -0,0 +1,164 @@
+#include <GBA/include/CPU/ARM7TDMI.hpp>
+#include <algorithm>
+#include <GBA/include/CPU/CpuTypes.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace cpu
+{
+void ARM7TDMI::SetBackend(CpuBackend backend)
+{
+    backend_ = backend;
+    ClearDecodedBlocks();
+}
+
+void ARM7TDMI::ClearDecodedBlocks()
+{
+    decodedBlocks_.clear();
+    decodedBlocksByChunk_.clear();
+    currentBlock_ = nullptr;
+    uncachedInstructions_ = 0;
+}
+
+void ARM7TDMI::InvalidateDecodedCode(u32 addr)
+{
+    auto chunk = decodedBlocksByChunk_.find(addr >> CODE_CHUNK_SHIFT);
+
+    if (chunk == decodedBlocksByChunk_.end())
+    {
+        return;
+    }
+
+    for (u32 key : chunk->second)
+    {
+        decodedBlocks_.erase(key);
+    }
+
+    decodedBlocksByChunk_.erase(chunk);
+    currentBlock_ = nullptr;
+
+    // Instructions already in the pipeline were fetched before this write and must execute as fetched, but they may not match
+    // memory anymore so they can't be cached.
+    uncachedInstructions_ = pipeline_.Size();
+}
+
+void ARM7TDMI::ExecuteCached(u32 instruction, u32 executedPC, bool armState)
+{
+    if ((uncachedInstructions_ > 0) || !SelectDecodedBlock(executedPC, armState))
+    {
+        if (uncachedInstructions_ > 0)
+        {
+            --uncachedInstructions_;
+        }
+
+        currentBlock_ = nullptr;
+
+        if (armState)
+        {
+            DecodeAndExecuteARM(instruction);
+        }
+        else
+        {
+            DecodeAndExecuteTHUMB(instruction);
+        }
+
+        return;
+    }
+
+    if (currentBlockIndex_ == currentBlock_->Instructions.size())
+    {
+        if (armState)
+        {
+            currentBlock_->Instructions.push_back({DecodeArm(instruction), nullptr, instruction});
+        }
+        else
+        {
+            currentBlock_->Instructions.push_back({nullptr, DecodeThumb(instruction), instruction});
+        }
+    }
+
+    // Copy the decoded instruction before executing it since a write to the code it came from will delete its block.
+    DecodedInstruction decoded = currentBlock_->Instructions[currentBlockIndex_];
+    currentBlockNextPC_ = executedPC + (armState ? 4 : 2);
+    ++currentBlockIndex_;
+
+    if (armState)
+    {
+        u8 conditionCode = (decoded.Opcode & 0xF000'0000) >> 28;
+
+        if ((conditionCode == 0x0E) || ConditionSatisfied(conditionCode))
+        {
+            (this->*decoded.Arm)(decoded.Opcode);
+        }
+    }
+    else
+    {
+        (this->*decoded.Thumb)(static_cast<u16>(decoded.Opcode));
+    }
+}
+
+bool ARM7TDMI::SelectDecodedBlock(u32 executedPC, bool armState)
+{
+    u32 chunk = executedPC >> CODE_CHUNK_SHIFT;
+    u32 key = executedPC | (armState ? 0 : 1);
+
+    if ((currentBlock_ == nullptr) || (executedPC != currentBlockNextPC_) || (armState != currentBlockArm_))
+    {
+        // Jumped somewhere else, so continue from a block that starts here or start a new one.
+        auto it = decodedBlocks_.find(key);
+
+        if (it == decodedBlocks_.end())
+        {
+            if (!ProtectCode(executedPC))
+            {
+                currentBlock_ = nullptr;
+                return false;
+            }
+
+            it = decodedBlocks_.emplace(key, DecodedBlock{{}, chunk, false}).first;
+            TrackDecodedBlock(chunk, key);
+        }
+
+        currentBlock_ = &it->second;
+        currentBlockArm_ = armState;
+        currentBlockIndex_ = 0;
+        return true;
+    }
+
+    if (currentBlockIndex_ < currentBlock_->Instructions.size())
+    {
+        return true;
+    }
+
+    if (currentBlock_->Complete)
+    {
+        return false;
+    }
+
+    if (chunk != currentBlock_->LastChunk)
+    {
+        if (!ProtectCode(executedPC))
+        {
+            currentBlock_->Complete = true;
+            return false;
+        }
+
+        // Register the block with each chunk it extends into so that writes to any of them delete it.
+        u32 blockStart = executedPC - (currentBlockIndex_ * (armState ? 4 : 2));
+        TrackDecodedBlock(chunk, blockStart | (armState ? 0 : 1));
+        currentBlock_->LastChunk = chunk;
+    }
+
+    return true;
+}
+
+void ARM7TDMI::TrackDecodedBlock(u32 chunk, u32 key)
+{
+    // A chunk can still list a block that was deleted through another chunk, so check before listing it again.
+    auto& keys = decodedBlocksByChunk_[chunk];
+
+    if (std::ranges::find(keys, key) == keys.end())
+    {
+        keys.push_back(key);
+    }
+}
+}  // namespace cpu
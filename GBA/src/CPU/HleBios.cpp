@@ -0,0 +1,785 @@
+#include <GBA/include/CPU/ARM7TDMI.hpp>
+#include <array>
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <stdexcept>
+#include <GBA/include/CPU/CpuTypes.hpp>
+#include <GBA/include/Memory/MemoryMap.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace
+{
+// Approximate cycle charges for the work the BIOS does between bus accesses. Bus accesses themselves are charged whatever the bus
+// reports, so these only stand in for the BIOS code's own instruction fetches and internal cycles.
+constexpr int SWI_OVERHEAD_CYCLES = 30;
+constexpr int DIV_CYCLES = 60;
+constexpr int SQRT_CYCLES = 150;
+constexpr int ARC_TAN_CYCLES = 50;
+constexpr int CPU_SET_CYCLES_PER_UNIT = 3;
+constexpr int CPU_FAST_SET_CYCLES_PER_BLOCK = 4;
+constexpr int BG_AFFINE_SET_CYCLES_PER_ENTRY = 60;
+constexpr int OBJ_AFFINE_SET_CYCLES_PER_ENTRY = 40;
+constexpr int BIT_UNPACK_CYCLES_PER_BYTE = 10;
+constexpr int DECOMPRESS_CYCLES_PER_BYTE = 6;
+
+// Addresses used by SoftReset
+constexpr u32 SOFT_RESET_CLEAR_ADDR_MIN = 0x0300'7E00;
+constexpr u32 SOFT_RESET_FLAG_ADDR = 0x0300'7FFA;
+
+// Addresses used by interrupt waits
+constexpr u32 BIOS_IF_ADDR = 0x0300'7FF8;
+constexpr u32 IME_ADDR = 0x0400'0208;
+constexpr u32 HALTCNT_ADDR = 0x0400'0301;
+
+// Registers given non-zero values by RegisterRamReset
+constexpr u32 DISPCNT_ADDR = 0x0400'0000;
+constexpr u32 BG2PA_ADDR = 0x0400'0020;
+constexpr u32 BG2PD_ADDR = 0x0400'0026;
+constexpr u32 BG3PA_ADDR = 0x0400'0030;
+constexpr u32 BG3PD_ADDR = 0x0400'0036;
+constexpr u32 SOUNDBIAS_ADDR = 0x0400'0088;
+constexpr u32 RCNT_ADDR = 0x0400'0134;
+constexpr u32 IE_ADDR = 0x0400'0200;
+constexpr u32 IF_ADDR = 0x0400'0202;
+constexpr u32 WAITCNT_ADDR = 0x0400'0204;
+
+// The top of IWRAM holds the stacks and interrupt vector, so RegisterRamReset leaves it alone.
+constexpr u32 IWRAM_RESET_ADDR_MAX = 0x0300'7DFF;
+
+/// @brief Build the BIOS sine table used by the affine set functions. Entries are sin(2 * pi * i / 256) as 1.1.14 fixed point.
+/// @return Sine table indexed by the upper byte of an angle.
+std::array<i16, 256> GenerateSineTable()
+{
+    std::array<i16, 256> table;
+
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        table[i] = static_cast<i16>(std::sin(2.0 * std::numbers::pi * static_cast<double>(i) / 256.0) * 0x4000);
+    }
+
+    return table;
+}
+
+std::array<i16, 256> const SINE_TABLE = GenerateSineTable();
+
+/// @brief Multiply two values with the wrap around of the ARM7TDMI's 32-bit multiplier.
+/// @return Lower 32 bits of the product.
+i32 Multiply(i32 a, i32 b)
+{
+    return static_cast<i32>(static_cast<u32>(a) * static_cast<u32>(b));
+}
+
+/// @brief Approximate arctan the same way the BIOS does, with a polynomial evaluated in 1.1.14 fixed point.
+/// @param tan Tangent of the angle as 1.1.14 fixed point, between -1.0 and 1.0 for an exact result.
+/// @param a Set to the negated square of tan, which the BIOS leaves in r1.
+/// @param b Set to the final polynomial value, which the BIOS leaves in r3.
+/// @return Angle from -pi/2 (0xC000) to pi/2 (0x4000).
+i32 ArcTan(i32 tan, i32& a, i32& b)
+{
+    a = -(Multiply(tan, tan) >> 14);
+    b = (Multiply(0xA9, a) >> 14) + 0x0390;
+    b = (Multiply(b, a) >> 14) + 0x091C;
+    b = (Multiply(b, a) >> 14) + 0x0FB6;
+    b = (Multiply(b, a) >> 14) + 0x16AA;
+    b = (Multiply(b, a) >> 14) + 0x2081;
+    b = (Multiply(b, a) >> 14) + 0x3651;
+    b = (Multiply(b, a) >> 14) + 0xA2F9;
+    return Multiply(tan, b) >> 16;
+}
+}
+
+namespace cpu
+{
+template <AccessSize Length>
+u32 ARM7TDMI::HleRead(u32 addr)
+{
+    auto [val, cycles] = ReadMemory<Length>(addr);
+    scheduler_.Step(cycles);
+    return val;
+}
+
+template <AccessSize Length>
+void ARM7TDMI::HleWrite(u32 addr, u32 val)
+{
+    int cycles = WriteMemory<Length>(addr, val);
+    scheduler_.Step(cycles);
+}
+
+bool ARM7TDMI::ExecuteHleBiosFunction(u8 function, u32 swiAddr)
+{
+    switch (function)
+    {
+        case 0x00:  // SoftReset
+            HleSoftReset();
+            break;
+        case 0x01:  // RegisterRamReset
+            HleRegisterRamReset();
+            break;
+        case 0x02:  // Halt
+            HleWrite<AccessSize::BYTE>(HALTCNT_ADDR, 0);
+            break;
+        case 0x03:  // Stop
+            // Stop mode isn't emulated and writing 0x80 to HALTCNT is ignored, so Stop returns straight away through a BIOS file too.
+            break;
+        case 0x04:  // IntrWait
+            HleIntrWait(registers_.ReadRegister(0) != 0, registers_.ReadRegister(1), swiAddr);
+            break;
+        case 0x05:  // VBlankIntrWait
+            HleIntrWait(true, 0x0001, swiAddr);
+            break;
+        case 0x06:  // Div
+            HleDiv(registers_.ReadRegister(0), registers_.ReadRegister(1));
+            break;
+        case 0x07:  // DivArm
+            HleDiv(registers_.ReadRegister(1), registers_.ReadRegister(0));
+            break;
+        case 0x08:  // Sqrt
+            HleSqrt();
+            break;
+        case 0x09:  // ArcTan
+            HleArcTan();
+            break;
+        case 0x0A:  // ArcTan2
+            HleArcTan2();
+            break;
+        case 0x0B:  // CpuSet
+            HleCpuSet();
+            break;
+        case 0x0C:  // CpuFastSet
+            HleCpuFastSet();
+            break;
+        case 0x0E:  // BgAffineSet
+            HleBgAffineSet();
+            break;
+        case 0x0F:  // ObjAffineSet
+            HleObjAffineSet();
+            break;
+        case 0x10:  // BitUnPack
+            HleBitUnPack();
+            break;
+        case 0x11:  // LZ77UnCompReadNormalWrite8bit
+            HleLZ77UnComp(false);
+            break;
+        case 0x12:  // LZ77UnCompReadNormalWrite16bit
+            HleLZ77UnComp(true);
+            break;
+        case 0x13:  // HuffUnCompReadNormal
+            HleHuffUnComp();
+            break;
+        case 0x14:  // RLUnCompReadNormalWrite8bit
+            HleRLUnComp(false);
+            break;
+        case 0x15:  // RLUnCompReadNormalWrite16bit
+            HleRLUnComp(true);
+            break;
+        case 0x19:  // SoundBias
+            // The BIOS ramps the SOUNDBIAS level towards 0 or 0x200 to avoid clicks when sound is turned off or on. The level only
+            // affects the analog output, which isn't emulated, so there's nothing to do.
+            break;
+        default:
+            if (builtInBios_)
+            {
+                throw std::runtime_error(std::format("BIOS function 0x{:02X} is not supported by the built-in BIOS", function));
+            }
+
+            return false;
+    }
+
+    scheduler_.Step(SWI_OVERHEAD_CYCLES);
+    return true;
+}
+
+void ARM7TDMI::HleSoftReset()
+{
+    bool restartFromEwram = HleRead<AccessSize::BYTE>(SOFT_RESET_FLAG_ADDR) != 0;
+
+    for (u32 addr = SOFT_RESET_CLEAR_ADDR_MIN; addr < IWRAM_ADDR_MAX; addr += 4)
+    {
+        HleWrite<AccessSize::WORD>(addr, 0);
+    }
+
+    registers_.SetOperatingMode(OperatingMode::IRQ);
+    registers_.WriteRegister(SP_INDEX, 0x0300'7FA0);
+    registers_.WriteRegister(LR_INDEX, 0);
+    registers_.SetSPSR(0);
+
+    registers_.SetOperatingMode(OperatingMode::Supervisor);
+    registers_.WriteRegister(SP_INDEX, 0x0300'7FE0);
+    registers_.WriteRegister(LR_INDEX, 0);
+    registers_.SetSPSR(0);
+
+    // Restart in ARM state and System mode with interrupts enabled, the same as after the BIOS intro.
+    registers_.SetCPSR(static_cast<u32>(OperatingMode::System));
+    registers_.WriteRegister(SP_INDEX, 0x0300'7F00);
+
+    for (u8 index = 0; index < SP_INDEX; ++index)
+    {
+        registers_.WriteRegister(index, 0);
+    }
+
+    registers_.SetPC(restartFromEwram ? EWRAM_ADDR_MIN : GAMEPAK_ROM_ADDR_MIN);
+    flushPipeline_ = true;
+    hleIntrWaitRetry_ = false;
+}
+
+void ARM7TDMI::HleRegisterRamReset()
+{
+    u8 flags = registers_.ReadRegister(0);
+
+    // The BIOS always forces blank, even if no flags are set.
+    HleWrite<AccessSize::HALFWORD>(DISPCNT_ADDR, 0x0080);
+
+    // Zero every word from addrMin through the word containing addrMax.
+    auto clear = [this](u32 addrMin, u32 addrMax)
+    {
+        for (u32 addr = addrMin; addr < addrMax; addr += 4)
+        {
+            HleWrite<AccessSize::WORD>(addr, 0);
+        }
+    };
+
+    if (flags & 0x01)
+    {
+        clear(EWRAM_ADDR_MIN, EWRAM_ADDR_MAX);
+    }
+
+    if (flags & 0x02)
+    {
+        clear(IWRAM_ADDR_MIN, IWRAM_RESET_ADDR_MAX);
+    }
+
+    if (flags & 0x04)
+    {
+        clear(PRAM_ADDR_MIN, PRAM_ADDR_MAX);
+    }
+
+    if (flags & 0x08)
+    {
+        clear(VRAM_ADDR_MIN, VRAM_ADDR_MAX);
+    }
+
+    if (flags & 0x10)
+    {
+        clear(OAM_ADDR_MIN, OAM_ADDR_MAX);
+    }
+
+    if (flags & 0x20)
+    {
+        clear(SERIAL_IO_1_ADDR_MIN, SERIAL_IO_1_ADDR_MAX);
+        HleWrite<AccessSize::HALFWORD>(RCNT_ADDR, 0x8000);
+    }
+
+    if (flags & 0x40)
+    {
+        // Stop at the FIFOs, since writing them would queue samples rather than clear anything.
+        clear(SOUND_IO_ADDR_MIN, FIFO_A_ADDR - 1);
+        HleWrite<AccessSize::HALFWORD>(SOUNDBIAS_ADDR, 0x0200);
+    }
+
+    if (flags & 0x80)
+    {
+        // DISPCNT keeps the forced blank written above.
+        clear(LCD_IO_ADDR_MIN + 4, LCD_IO_ADDR_MAX);
+        HleWrite<AccessSize::HALFWORD>(BG2PA_ADDR, 0x0100);
+        HleWrite<AccessSize::HALFWORD>(BG2PD_ADDR, 0x0100);
+        HleWrite<AccessSize::HALFWORD>(BG3PA_ADDR, 0x0100);
+        HleWrite<AccessSize::HALFWORD>(BG3PD_ADDR, 0x0100);
+        clear(DMA_IO_ADDR_MIN, DMA_IO_ADDR_MAX);
+        clear(TIMER_IO_ADDR_MIN, TIMER_IO_ADDR_MAX);
+        HleWrite<AccessSize::HALFWORD>(IE_ADDR, 0);
+        HleWrite<AccessSize::HALFWORD>(IF_ADDR, U16_MAX);
+        HleWrite<AccessSize::HALFWORD>(WAITCNT_ADDR, 0);
+        HleWrite<AccessSize::HALFWORD>(IME_ADDR, 0);
+    }
+}
+
+void ARM7TDMI::HleIntrWait(bool discardOldFlags, u16 flags, u32 swiAddr)
+{
+    HleWrite<AccessSize::HALFWORD>(IME_ADDR, 1);
+    u16 biosIF = HleRead<AccessSize::HALFWORD>(BIOS_IF_ADDR);
+
+    if (discardOldFlags && !hleIntrWaitRetry_)
+    {
+        HleWrite<AccessSize::HALFWORD>(BIOS_IF_ADDR, biosIF & ~flags);
+    }
+    else if ((biosIF & flags) != 0)
+    {
+        HleWrite<AccessSize::HALFWORD>(BIOS_IF_ADDR, biosIF & ~flags);
+        hleIntrWaitRetry_ = false;
+        return;
+    }
+
+    // Halt, then run the SWI again once the game's interrupt handler returns to it. Old flags were already discarded, so the retry
+    // only checks for new ones.
+    HleWrite<AccessSize::BYTE>(HALTCNT_ADDR, 0);
+    registers_.SetPC(swiAddr);
+    flushPipeline_ = true;
+    hleIntrWaitRetry_ = true;
+}
+
+void ARM7TDMI::HleDiv(i32 numerator, i32 denominator)
+{
+    i32 quotient;
+    i32 remainder;
+
+    if (denominator == 0)
+    {
+        // The BIOS never finishes dividing by 0. Return something sensible instead of hanging.
+        quotient = (numerator < 0) ? -1 : 1;
+        remainder = numerator;
+    }
+    else
+    {
+        i64 wideQuotient = static_cast<i64>(numerator) / denominator;
+        quotient = static_cast<i32>(static_cast<u32>(wideQuotient));
+        remainder = static_cast<i32>(static_cast<i64>(numerator) % denominator);
+    }
+
+    registers_.WriteRegister(0, quotient);
+    registers_.WriteRegister(1, remainder);
+    registers_.WriteRegister(3, (quotient < 0) ? -static_cast<u32>(quotient) : quotient);
+    scheduler_.Step(DIV_CYCLES);
+}
+
+void ARM7TDMI::HleSqrt()
+{
+    u32 val = registers_.ReadRegister(0);
+    u32 root = 0;
+
+    for (u32 bit = 1 << 15; bit != 0; bit >>= 1)
+    {
+        u32 candidate = root | bit;
+
+        if ((candidate * candidate) <= val)
+        {
+            root = candidate;
+        }
+    }
+
+    registers_.WriteRegister(0, root);
+    scheduler_.Step(SQRT_CYCLES);
+}
+
+void ARM7TDMI::HleArcTan()
+{
+    i32 a;
+    i32 b;
+    i32 angle = ArcTan(registers_.ReadRegister(0), a, b);
+    registers_.WriteRegister(0, angle);
+    registers_.WriteRegister(1, a);
+    registers_.WriteRegister(3, b);
+    scheduler_.Step(ARC_TAN_CYCLES);
+}
+
+void ARM7TDMI::HleArcTan2()
+{
+    i32 x = static_cast<i16>(registers_.ReadRegister(0));
+    i32 y = static_cast<i16>(registers_.ReadRegister(1));
+    i32 a = 0;
+    i32 b = 0;
+    i32 angle;
+
+    // Reduce to an octant where |tan| <= 1, where the polynomial is accurate, and offset the result back into the full circle.
+    if (y == 0)
+    {
+        angle = (x >= 0) ? 0x0000 : 0x8000;
+    }
+    else if (x == 0)
+    {
+        angle = (y >= 0) ? 0x4000 : 0xC000;
+    }
+    else if (y >= 0)
+    {
+        if ((x >= 0) && (x >= y))
+        {
+            angle = ArcTan((y << 14) / x, a, b);
+        }
+        else if ((x < 0) && (-x >= y))
+        {
+            angle = ArcTan((y << 14) / x, a, b) + 0x8000;
+        }
+        else
+        {
+            angle = 0x4000 - ArcTan((x << 14) / y, a, b);
+        }
+    }
+    else
+    {
+        if ((x <= 0) && (-x > -y))
+        {
+            angle = ArcTan((y << 14) / x, a, b) + 0x8000;
+        }
+        else if ((x > 0) && (x >= -y))
+        {
+            angle = ArcTan((y << 14) / x, a, b) + 0x1'0000;
+        }
+        else
+        {
+            angle = 0xC000 - ArcTan((x << 14) / y, a, b);
+        }
+    }
+
+    registers_.WriteRegister(0, angle & U16_MAX);
+    registers_.WriteRegister(1, a);
+    registers_.WriteRegister(3, b);
+    scheduler_.Step(ARC_TAN_CYCLES);
+}
+
+void ARM7TDMI::HleCpuSet()
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 dest = registers_.ReadRegister(1);
+    u32 control = registers_.ReadRegister(2);
+    u32 count = control & 0x001F'FFFF;
+    bool fill = (control & 0x0100'0000) != 0;
+    bool wordTransfer = (control & 0x0400'0000) != 0;
+    u32 step = wordTransfer ? 4 : 2;
+
+    src &= ~(step - 1);
+    dest &= ~(step - 1);
+    u32 fillVal = 0;
+
+    if (fill)
+    {
+        fillVal = wordTransfer ? HleRead<AccessSize::WORD>(src) : HleRead<AccessSize::HALFWORD>(src);
+    }
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 val = fillVal;
+
+        if (!fill)
+        {
+            val = wordTransfer ? HleRead<AccessSize::WORD>(src) : HleRead<AccessSize::HALFWORD>(src);
+            src += step;
+        }
+
+        if (wordTransfer)
+        {
+            HleWrite<AccessSize::WORD>(dest, val);
+        }
+        else
+        {
+            HleWrite<AccessSize::HALFWORD>(dest, val);
+        }
+
+        dest += step;
+        scheduler_.Step(CPU_SET_CYCLES_PER_UNIT);
+    }
+}
+
+void ARM7TDMI::HleCpuFastSet()
+{
+    u32 src = registers_.ReadRegister(0) & ~0x03;
+    u32 dest = registers_.ReadRegister(1) & ~0x03;
+    u32 control = registers_.ReadRegister(2);
+    bool fill = (control & 0x0100'0000) != 0;
+
+    // Transfers are done in blocks of 8 words, so the count is rounded up to the next multiple of 8.
+    u32 count = ((control & 0x001F'FFFF) + 7) & ~0x07;
+    u32 fillVal = fill ? HleRead<AccessSize::WORD>(src) : 0;
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 val = fillVal;
+
+        if (!fill)
+        {
+            val = HleRead<AccessSize::WORD>(src);
+            src += 4;
+        }
+
+        HleWrite<AccessSize::WORD>(dest, val);
+        dest += 4;
+
+        if ((i & 0x07) == 0x07)
+        {
+            scheduler_.Step(CPU_FAST_SET_CYCLES_PER_BLOCK);
+        }
+    }
+}
+
+void ARM7TDMI::HleBgAffineSet()
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 dest = registers_.ReadRegister(1);
+    u32 count = registers_.ReadRegister(2);
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        i32 originX = HleRead<AccessSize::WORD>(src);
+        i32 originY = HleRead<AccessSize::WORD>(src + 4);
+        i32 displayX = static_cast<i16>(HleRead<AccessSize::HALFWORD>(src + 8));
+        i32 displayY = static_cast<i16>(HleRead<AccessSize::HALFWORD>(src + 10));
+        i32 scaleX = static_cast<i16>(HleRead<AccessSize::HALFWORD>(src + 12));
+        i32 scaleY = static_cast<i16>(HleRead<AccessSize::HALFWORD>(src + 14));
+        u8 angle = HleRead<AccessSize::HALFWORD>(src + 16) >> 8;
+        src += 20;
+
+        i32 sin = SINE_TABLE[angle];
+        i32 cos = SINE_TABLE[static_cast<u8>(angle + 64)];
+        i32 pa = (scaleX * cos) >> 14;
+        i32 pb = -(scaleX * sin) >> 14;
+        i32 pc = (scaleY * sin) >> 14;
+        i32 pd = (scaleY * cos) >> 14;
+
+        // Start the reference point so that the original image's center lands on the display center.
+        HleWrite<AccessSize::HALFWORD>(dest, pa);
+        HleWrite<AccessSize::HALFWORD>(dest + 2, pb);
+        HleWrite<AccessSize::HALFWORD>(dest + 4, pc);
+        HleWrite<AccessSize::HALFWORD>(dest + 6, pd);
+        HleWrite<AccessSize::WORD>(dest + 8, originX - ((pa * displayX) + (pb * displayY)));
+        HleWrite<AccessSize::WORD>(dest + 12, originY - ((pc * displayX) + (pd * displayY)));
+        dest += 16;
+        scheduler_.Step(BG_AFFINE_SET_CYCLES_PER_ENTRY);
+    }
+}
+
+void ARM7TDMI::HleObjAffineSet()
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 dest = registers_.ReadRegister(1);
+    u32 count = registers_.ReadRegister(2);
+    u32 stride = registers_.ReadRegister(3);
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        i32 scaleX = static_cast<i16>(HleRead<AccessSize::HALFWORD>(src));
+        i32 scaleY = static_cast<i16>(HleRead<AccessSize::HALFWORD>(src + 2));
+        u8 angle = HleRead<AccessSize::HALFWORD>(src + 4) >> 8;
+        src += 8;
+
+        i32 sin = SINE_TABLE[angle];
+        i32 cos = SINE_TABLE[static_cast<u8>(angle + 64)];
+
+        HleWrite<AccessSize::HALFWORD>(dest, (scaleX * cos) >> 14);
+        HleWrite<AccessSize::HALFWORD>(dest + stride, -(scaleX * sin) >> 14);
+        HleWrite<AccessSize::HALFWORD>(dest + (2 * stride), (scaleY * sin) >> 14);
+        HleWrite<AccessSize::HALFWORD>(dest + (3 * stride), (scaleY * cos) >> 14);
+        dest += 4 * stride;
+        scheduler_.Step(OBJ_AFFINE_SET_CYCLES_PER_ENTRY);
+    }
+}
+
+void ARM7TDMI::HleBitUnPack()
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 dest = registers_.ReadRegister(1) & ~0x03;
+    u32 info = registers_.ReadRegister(2);
+
+    u32 srcLength = HleRead<AccessSize::HALFWORD>(info);
+    u8 srcWidth = HleRead<AccessSize::BYTE>(info + 2);
+    u8 destWidth = HleRead<AccessSize::BYTE>(info + 3);
+    u32 offset = HleRead<AccessSize::WORD>(info + 4);
+    bool offsetZeroes = (offset & U32_MSB) != 0;
+    offset &= ~U32_MSB;
+
+    bool validSrcWidth = (srcWidth == 1) || (srcWidth == 2) || (srcWidth == 4) || (srcWidth == 8);
+    bool validDestWidth = (destWidth == 1) || (destWidth == 2) || (destWidth == 4) || (destWidth == 8) || (destWidth == 16) ||
+                          (destWidth == 32);
+
+    if (!validSrcWidth || !validDestWidth || (destWidth < srcWidth))
+    {
+        return;
+    }
+
+    u32 outputWord = 0;
+    u8 outputBits = 0;
+
+    for (u32 i = 0; i < srcLength; ++i)
+    {
+        u8 srcByte = HleRead<AccessSize::BYTE>(src++);
+
+        for (u8 bit = 0; bit < 8; bit += srcWidth)
+        {
+            u32 val = (srcByte >> bit) & ((1 << srcWidth) - 1);
+
+            if ((val != 0) || offsetZeroes)
+            {
+                val += offset;
+            }
+
+            outputWord |= val << outputBits;
+            outputBits += destWidth;
+
+            if (outputBits == 32)
+            {
+                HleWrite<AccessSize::WORD>(dest, outputWord);
+                dest += 4;
+                outputWord = 0;
+                outputBits = 0;
+            }
+        }
+
+        scheduler_.Step(BIT_UNPACK_CYCLES_PER_BYTE);
+    }
+}
+
+void ARM7TDMI::HleLZ77UnComp(bool vram)
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 header = HleRead<AccessSize::WORD>(src);
+    u32 size = header >> 8;
+    src += 4;
+
+    DecompressedOutput output = {registers_.ReadRegister(1), 0, 0, vram};
+
+    while (output.BytesProduced < size)
+    {
+        u8 flags = HleRead<AccessSize::BYTE>(src++);
+
+        for (int block = 0; (block < 8) && (output.BytesProduced < size); ++block, flags <<= 1)
+        {
+            if ((flags & U8_MSB) == 0)
+            {
+                HleWriteDecompressed(output, HleRead<AccessSize::BYTE>(src++));
+                continue;
+            }
+
+            u8 hi = HleRead<AccessSize::BYTE>(src++);
+            u8 lo = HleRead<AccessSize::BYTE>(src++);
+            u32 length = (hi >> 4) + 3;
+            u32 disp = (((hi & 0x0F) << 8) | lo) + 1;
+
+            for (u32 i = 0; (i < length) && (output.BytesProduced < size); ++i)
+            {
+                // Like the BIOS, copy from memory rather than from the output produced so far. Displacements that reach back before
+                // the start of the output read whatever was already there, and in 16-bit mode a displacement of 1 reads the byte of
+                // the pending halfword that hasn't been written yet.
+                u32 addr = output.Dest + output.BytesProduced - disp;
+                u8 val;
+
+                if (vram)
+                {
+                    val = HleRead<AccessSize::HALFWORD>(addr & ~0x01) >> ((addr & 0x01) * 8);
+                }
+                else
+                {
+                    val = HleRead<AccessSize::BYTE>(addr);
+                }
+
+                HleWriteDecompressed(output, val);
+            }
+        }
+    }
+}
+
+void ARM7TDMI::HleHuffUnComp()
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 dest = registers_.ReadRegister(1);
+    u32 header = HleRead<AccessSize::WORD>(src);
+    u32 size = header >> 8;
+    u8 bitsPerSymbol = header & 0x0F;
+
+    if ((bitsPerSymbol != 4) && (bitsPerSymbol != 8))
+    {
+        return;
+    }
+
+    u32 treeSize = (HleRead<AccessSize::BYTE>(src + 4) + 1) * 2;
+    u32 rootAddr = src + 5;
+    u32 bitstreamAddr = src + 4 + treeSize;
+
+    u32 nodeAddr = rootAddr;
+    u8 node = HleRead<AccessSize::BYTE>(rootAddr);
+    u32 outputWord = 0;
+    u8 outputBits = 0;
+    u32 bytesWritten = 0;
+
+    while (bytesWritten < size)
+    {
+        u32 bitstream = HleRead<AccessSize::WORD>(bitstreamAddr);
+        bitstreamAddr += 4;
+
+        for (int bit = 31; (bit >= 0) && (bytesWritten < size); --bit)
+        {
+            bool right = ((bitstream >> bit) & 0x01) != 0;
+            u32 childAddr = (nodeAddr & ~0x01) + ((node & 0x3F) * 2) + 2 + (right ? 1 : 0);
+            bool leaf = (node & (right ? 0x40 : 0x80)) != 0;
+            u8 child = HleRead<AccessSize::BYTE>(childAddr);
+
+            if (!leaf)
+            {
+                nodeAddr = childAddr;
+                node = child;
+                continue;
+            }
+
+            outputWord |= static_cast<u32>(child & ((1 << bitsPerSymbol) - 1)) << outputBits;
+            outputBits += bitsPerSymbol;
+            nodeAddr = rootAddr;
+            node = HleRead<AccessSize::BYTE>(rootAddr);
+
+            if (outputBits == 32)
+            {
+                HleWrite<AccessSize::WORD>(dest, outputWord);
+                dest += 4;
+                bytesWritten += 4;
+                outputWord = 0;
+                outputBits = 0;
+                scheduler_.Step(4 * DECOMPRESS_CYCLES_PER_BYTE);
+            }
+        }
+    }
+}
+
+void ARM7TDMI::HleRLUnComp(bool vram)
+{
+    u32 src = registers_.ReadRegister(0);
+    u32 header = HleRead<AccessSize::WORD>(src);
+    u32 size = header >> 8;
+    src += 4;
+
+    DecompressedOutput output = {registers_.ReadRegister(1), 0, 0, vram};
+
+    while (output.BytesProduced < size)
+    {
+        u8 flag = HleRead<AccessSize::BYTE>(src++);
+
+        if ((flag & U8_MSB) != 0)
+        {
+            u32 length = (flag & 0x7F) + 3;
+            u8 val = HleRead<AccessSize::BYTE>(src++);
+
+            for (u32 i = 0; (i < length) && (output.BytesProduced < size); ++i)
+            {
+                HleWriteDecompressed(output, val);
+            }
+        }
+        else
+        {
+            u32 length = (flag & 0x7F) + 1;
+
+            for (u32 i = 0; (i < length) && (output.BytesProduced < size); ++i)
+            {
+                HleWriteDecompressed(output, HleRead<AccessSize::BYTE>(src++));
+            }
+        }
+    }
+}
+
+void ARM7TDMI::HleWriteDecompressed(DecompressedOutput& output, u8 val)
+{
+    u32 offset = output.BytesProduced++;
+
+    if (!output.Vram)
+    {
+        HleWrite<AccessSize::BYTE>(output.Dest + offset, val);
+        scheduler_.Step(DECOMPRESS_CYCLES_PER_BYTE);
+        return;
+    }
+
+    // A trailing odd byte is never written since the BIOS only writes once it has a full halfword.
+    if ((offset & 0x01) == 0)
+    {
+        output.PendingByte = val;
+    }
+    else
+    {
+        HleWrite<AccessSize::HALFWORD>(output.Dest + offset - 1, output.PendingByte | (val << 8));
+        scheduler_.Step(2 * DECOMPRESS_CYCLES_PER_BYTE);
+    }
+}
+}  // namespace cpu
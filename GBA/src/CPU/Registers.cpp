@@ -1,4 +1,5 @@
 #include <GBA/include/CPU/Registers.hpp>
+#include <algorithm>
 #include <bit>
 #include <format>
 #include <fstream>
@@ -324,6 +325,21 @@ void Registers::SetCPSR(u32 val)
     cpsr_ = newCpsr;
 }
 
+Registers::Snapshot Registers::GetSnapshot() const
+{
+    Snapshot snapshot;
+    auto it = snapshot.begin();
+    *it++ = std::bit_cast<u32>(cpsr_);
+    *it++ = std::bit_cast<u32>(spsr_);
+    it = std::copy(gpRegisters_.begin(), gpRegisters_.end(), it);
+    it = std::copy(fiqRegisters_.begin(), fiqRegisters_.end(), it);
+    it = std::copy(svcRegisters_.begin(), svcRegisters_.end(), it);
+    it = std::copy(abtRegisters_.begin(), abtRegisters_.end(), it);
+    it = std::copy(irqRegisters_.begin(), irqRegisters_.end(), it);
+    std::copy(undRegisters_.begin(), undRegisters_.end(), it);
+    return snapshot;
+}
+
 void Registers::Serialize(std::ofstream& saveState) const
 {
     SerializeTrivialType(cpsr_);
@@ -350,7 +366,10 @@ void Registers::Deserialize(std::ifstream& saveState)
 
 void Registers::SkipBIOS()
 {
+    // The BIOS hands control to the GamePak in System mode with IRQs and FIQs enabled.
     cpsr_.Mode = std::bit_cast<u32>(OperatingMode::System);
+    SetIrqDisabled(false);
+    SetFiqDisabled(false);
     spsr_ = cpsr_;
     SetPC(0x0800'0000);
     WriteRegister(SP_INDEX, 0x0300'7F00, OperatingMode::System);
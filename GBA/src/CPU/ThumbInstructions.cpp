@@ -1,4 +1,5 @@
 #include <GBA/include/CPU/ARM7TDMI.hpp>
+#include <array>
 #include <bit>
 #include <cstring>
 #include <stdexcept>
@@ -95,93 +96,84 @@ namespace cpu
 {
 using namespace thumb;
 
-void ARM7TDMI::DecodeAndExecuteTHUMB(u16 instruction)
+constexpr std::array<ARM7TDMI::ThumbHandler, 1024> ARM7TDMI::GenerateThumbDecodeTable()
 {
-    if (SoftwareInterrupt::IsInstanceOf(instruction))
-    {
-        ExecuteThumbSoftwareInterrupt(instruction);
-    }
-    else if (UnconditionalBranch::IsInstanceOf(instruction))
-    {
-        ExecuteUnconditionalBranch(instruction);
-    }
-    else if (ConditionalBranch::IsInstanceOf(instruction))
-    {
-        ExecuteConditionalBranch(instruction);
-    }
-    else if (MultipleLoadStore::IsInstanceOf(instruction))
-    {
-        ExecuteMultipleLoadStore(instruction);
-    }
-    else if (LongBranchWithLink::IsInstanceOf(instruction))
-    {
-        ExecuteLongBranchWithLink(instruction);
-    }
-    else if (AddOffsetToStackPointer::IsInstanceOf(instruction))
-    {
-        ExecuteAddOffsetToStackPointer(instruction);
-    }
-    else if (PushPopRegisters::IsInstanceOf(instruction))
-    {
-        ExecutePushPopRegisters(instruction);
-    }
-    else if (LoadStoreHalfword::IsInstanceOf(instruction))
-    {
-        ExecuteLoadStoreHalfword(instruction);
-    }
-    else if (SPRelativeLoadStore::IsInstanceOf(instruction))
-    {
-        ExecuteSPRelativeLoadStore(instruction);
-    }
-    else if (LoadAddress::IsInstanceOf(instruction))
-    {
-        ExecuteLoadAddress(instruction);
-    }
-    else if (LoadStoreWithImmOffset::IsInstanceOf(instruction))
-    {
-        ExecuteLoadStoreWithOffset(instruction);
-    }
-    else if (LoadStoreWithRegOffset::IsInstanceOf(instruction))
-    {
-        ExecuteLoadStoreWithOffset(instruction);
-    }
-    else if (LoadStoreSignExtendedByteHalfword::IsInstanceOf(instruction))
-    {
-        ExecuteLoadStoreSignExtendedByteHalfword(instruction);
-    }
-    else if (PCRelativeLoad::IsInstanceOf(instruction))
-    {
-        ExecutePCRelativeLoad(instruction);
-    }
-    else if (HiRegisterOperationsBranchExchange::IsInstanceOf(instruction))
-    {
-        ExecuteHiRegisterOperationsBranchExchange(instruction);
-    }
-    else if (ALUOperations::IsInstanceOf(instruction))
-    {
-        ExecuteALUOperations(instruction);
-    }
-    else if (MoveCompareAddSubtractImmediate::IsInstanceOf(instruction))
-    {
-        ExecuteMoveCompareAddSubtractImmediate(instruction);
-    }
-    else if (AddSubtract::IsInstanceOf(instruction))
-    {
-        ExecuteAddSubtract(instruction);
-    }
-    else if (MoveShiftedRegister::IsInstanceOf(instruction))
-    {
-        ExecuteMoveShiftedRegister(instruction);
-    }
-    else
-    {
-        throw std::runtime_error("Unable to decode THUMB instruction");
+    struct ThumbFormat
+    {
+        u16 format;
+        u16 formatMask;
+        ThumbHandler handler;
+    };
+
+    // Formats are checked in priority order. Every format mask fits within the top 10 bits, so each index decodes exactly.
+    constexpr std::array<ThumbFormat, 19> formats = {{
+        {SoftwareInterrupt::FORMAT, SoftwareInterrupt::FORMAT_MASK, &ARM7TDMI::ExecuteThumbSoftwareInterrupt},
+        {UnconditionalBranch::FORMAT, UnconditionalBranch::FORMAT_MASK, &ARM7TDMI::ExecuteUnconditionalBranch},
+        {ConditionalBranch::FORMAT, ConditionalBranch::FORMAT_MASK, &ARM7TDMI::ExecuteConditionalBranch},
+        {MultipleLoadStore::FORMAT, MultipleLoadStore::FORMAT_MASK, &ARM7TDMI::ExecuteMultipleLoadStore},
+        {LongBranchWithLink::FORMAT, LongBranchWithLink::FORMAT_MASK, &ARM7TDMI::ExecuteLongBranchWithLink},
+        {AddOffsetToStackPointer::FORMAT, AddOffsetToStackPointer::FORMAT_MASK, &ARM7TDMI::ExecuteAddOffsetToStackPointer},
+        {PushPopRegisters::FORMAT, PushPopRegisters::FORMAT_MASK, &ARM7TDMI::ExecutePushPopRegisters},
+        {LoadStoreHalfword::FORMAT, LoadStoreHalfword::FORMAT_MASK, &ARM7TDMI::ExecuteLoadStoreHalfword},
+        {SPRelativeLoadStore::FORMAT, SPRelativeLoadStore::FORMAT_MASK, &ARM7TDMI::ExecuteSPRelativeLoadStore},
+        {LoadAddress::FORMAT, LoadAddress::FORMAT_MASK, &ARM7TDMI::ExecuteLoadAddress},
+        {LoadStoreWithImmOffset::FORMAT, LoadStoreWithImmOffset::FORMAT_MASK, &ARM7TDMI::ExecuteLoadStoreWithOffset},
+        {LoadStoreWithRegOffset::FORMAT, LoadStoreWithRegOffset::FORMAT_MASK, &ARM7TDMI::ExecuteLoadStoreWithOffset},
+        {LoadStoreSignExtendedByteHalfword::FORMAT, LoadStoreSignExtendedByteHalfword::FORMAT_MASK, &ARM7TDMI::ExecuteLoadStoreSignExtendedByteHalfword},
+        {PCRelativeLoad::FORMAT, PCRelativeLoad::FORMAT_MASK, &ARM7TDMI::ExecutePCRelativeLoad},
+        {HiRegisterOperationsBranchExchange::FORMAT, HiRegisterOperationsBranchExchange::FORMAT_MASK, &ARM7TDMI::ExecuteHiRegisterOperationsBranchExchange},
+        {ALUOperations::FORMAT, ALUOperations::FORMAT_MASK, &ARM7TDMI::ExecuteALUOperations},
+        {MoveCompareAddSubtractImmediate::FORMAT, MoveCompareAddSubtractImmediate::FORMAT_MASK, &ARM7TDMI::ExecuteMoveCompareAddSubtractImmediate},
+        {AddSubtract::FORMAT, AddSubtract::FORMAT_MASK, &ARM7TDMI::ExecuteAddSubtract},
+        {MoveShiftedRegister::FORMAT, MoveShiftedRegister::FORMAT_MASK, &ARM7TDMI::ExecuteMoveShiftedRegister},
+    }};
+
+    std::array<ThumbHandler, 1024> table = {};
+
+    for (u16 index = 0; index < table.size(); ++index)
+    {
+        u16 instruction = index << 6;
+        ThumbHandler handler = &ARM7TDMI::ExecuteUndecodableThumb;
+
+        for (auto const& [format, formatMask, formatHandler] : formats)
+        {
+            if ((instruction & formatMask) == format)
+            {
+                handler = formatHandler;
+                break;
+            }
+        }
+
+        table[index] = handler;
     }
+
+    return table;
 }
 
-void ARM7TDMI::ExecuteThumbSoftwareInterrupt(u16 instruction)
+void ARM7TDMI::DecodeAndExecuteTHUMB(u16 instruction)
+{
+    (this->*DecodeThumb(instruction))(instruction);
+}
+
+ARM7TDMI::ThumbHandler ARM7TDMI::DecodeThumb(u16 instruction)
+{
+    static constexpr std::array<ThumbHandler, 1024> THUMB_DECODE_TABLE = GenerateThumbDecodeTable();
+    return THUMB_DECODE_TABLE[instruction >> 6];
+}
+
+void ARM7TDMI::ExecuteUndecodableThumb(u16 instruction)
 {
     (void)instruction;
+    throw std::runtime_error("Unable to decode THUMB instruction");
+}
+
+void ARM7TDMI::ExecuteThumbSoftwareInterrupt(u16 instruction)
+{
+    if (hleBios_ && ExecuteHleBiosFunction(instruction & U8_MAX, registers_.GetPC() - 4))
+    {
+        return;
+    }
+
     u32 cpsr = registers_.GetCPSR();
     registers_.SetOperatingState(OperatingState::ARM);
     registers_.SetOperatingMode(OperatingMode::Supervisor);
@@ -239,7 +231,7 @@ void ARM7TDMI::ExecuteMultipleLoadStore(u16 instruction)
         {
             if (regList & 0x01)
             {
-                auto [val, readCycles] = ReadMemory(addr, AccessSize::WORD);
+                auto [val, readCycles] = ReadMemory<AccessSize::WORD>(addr);
                 scheduler_.Step(readCycles);
                 registers_.WriteRegister(regIndex, val);
                 addr += 4;
@@ -251,7 +243,7 @@ void ARM7TDMI::ExecuteMultipleLoadStore(u16 instruction)
 
         if (emptyRlist)
         {
-            auto [val, readCycles] = ReadMemory(addr, AccessSize::WORD);
+            auto [val, readCycles] = ReadMemory<AccessSize::WORD>(addr);
             scheduler_.Step(readCycles);
             registers_.SetPC(val);
             flushPipeline_ = true;
@@ -272,7 +264,7 @@ void ARM7TDMI::ExecuteMultipleLoadStore(u16 instruction)
                     val = wbAddr;
                 }
 
-                int writeCycles = WriteMemory(addr, val, AccessSize::WORD);
+                int writeCycles = WriteMemory<AccessSize::WORD>(addr, val);
                 scheduler_.Step(writeCycles);
                 addr += 4;
             }
@@ -284,7 +276,7 @@ void ARM7TDMI::ExecuteMultipleLoadStore(u16 instruction)
         if (emptyRlist)
         {
             u32 value = registers_.GetPC() + 2;
-            int writeCycles = WriteMemory(addr, value, AccessSize::WORD);
+            int writeCycles = WriteMemory<AccessSize::WORD>(addr, value);
             scheduler_.Step(writeCycles);
         }
     }
@@ -354,7 +346,7 @@ void ARM7TDMI::ExecutePushPopRegisters(u16 instruction)
         {
             if (regList & 0x01)
             {
-                auto [val, readCycles] = ReadMemory(addr, AccessSize::WORD);
+                auto [val, readCycles] = ReadMemory<AccessSize::WORD>(addr);
                 scheduler_.Step(readCycles);
                 registers_.WriteRegister(regIndex, val);
                 addr += 4;
@@ -366,7 +358,7 @@ void ARM7TDMI::ExecutePushPopRegisters(u16 instruction)
 
         if (flags.R || emptyRlist)
         {
-            auto [val, readCycles] = ReadMemory(addr, AccessSize::WORD);
+            auto [val, readCycles] = ReadMemory<AccessSize::WORD>(addr);
             scheduler_.Step(readCycles);
             registers_.SetPC(val);
             addr += 4;
@@ -380,14 +372,14 @@ void ARM7TDMI::ExecutePushPopRegisters(u16 instruction)
         {
             addr -= 4;
             u32 val = registers_.ReadRegister(LR_INDEX);
-            int writeCycles = WriteMemory(addr, val, AccessSize::WORD);
+            int writeCycles = WriteMemory<AccessSize::WORD>(addr, val);
             scheduler_.Step(writeCycles);
         }
         else if (emptyRlist)
         {
             addr -= 4;
             u32 val = registers_.GetPC() + 2;
-            int writeCycles = WriteMemory(addr, val, AccessSize::WORD);
+            int writeCycles = WriteMemory<AccessSize::WORD>(addr, val);
             scheduler_.Step(writeCycles);
         }
 
@@ -399,7 +391,7 @@ void ARM7TDMI::ExecutePushPopRegisters(u16 instruction)
             {
                 addr -= 4;
                 u32 value = registers_.ReadRegister(regIndex);
-                int writeCycles = WriteMemory(addr, value, AccessSize::WORD);
+                int writeCycles = WriteMemory<AccessSize::WORD>(addr, value);
                 scheduler_.Step(writeCycles);
             }
 
@@ -431,7 +423,7 @@ void ARM7TDMI::ExecuteLoadStoreHalfword(u16 instruction)
 
     if (flags.L)
     {
-        auto [val, readCycles] = ReadMemory(addr, AccessSize::HALFWORD);
+        auto [val, readCycles] = ReadMemory<AccessSize::HALFWORD>(addr);
         scheduler_.Step(readCycles);
 
         if (addr & 0x01)
@@ -445,7 +437,7 @@ void ARM7TDMI::ExecuteLoadStoreHalfword(u16 instruction)
     else
     {
         u16 val = registers_.ReadRegister(flags.Rd);
-        int writeCycles = WriteMemory(addr, val, AccessSize::HALFWORD);
+        int writeCycles = WriteMemory<AccessSize::HALFWORD>(addr, val);
         scheduler_.Step(writeCycles);
     }
 }
@@ -457,7 +449,7 @@ void ARM7TDMI::ExecuteSPRelativeLoadStore(u16 instruction)
 
     if (flags.L)
     {
-        auto [val, readCycles] = ReadMemory(addr, AccessSize::WORD);
+        auto [val, readCycles] = ReadMemory<AccessSize::WORD>(addr);
         scheduler_.Step(readCycles);
 
         if (addr & 0x03)
@@ -471,7 +463,7 @@ void ARM7TDMI::ExecuteSPRelativeLoadStore(u16 instruction)
     else
     {
         u32 val = registers_.ReadRegister(flags.Rd);
-        int writeCycles = WriteMemory(addr, val, AccessSize::WORD);
+        int writeCycles = WriteMemory<AccessSize::WORD>(addr, val);
         scheduler_.Step(writeCycles);
     }
 }
@@ -522,7 +514,8 @@ void ARM7TDMI::ExecuteLoadStoreWithOffset(u16 instruction)
 
     if (load)
     {
-        auto [val, readCycles] = ReadMemory(addr, length);
+        auto [val, readCycles] =
+            (length == AccessSize::BYTE) ? ReadMemory<AccessSize::BYTE>(addr) : ReadMemory<AccessSize::WORD>(addr);
         scheduler_.Step(readCycles);
 
         if ((length == AccessSize::WORD) && (addr & 0x03))
@@ -536,7 +529,8 @@ void ARM7TDMI::ExecuteLoadStoreWithOffset(u16 instruction)
     else
     {
         u32 val = registers_.ReadRegister(Rd);
-        int writeCycles = WriteMemory(addr, val, length);
+        int writeCycles =
+            (length == AccessSize::BYTE) ? WriteMemory<AccessSize::BYTE>(addr, val) : WriteMemory<AccessSize::WORD>(addr, val);
         scheduler_.Step(writeCycles);
     }
 }
@@ -562,13 +556,13 @@ void ARM7TDMI::ExecuteLoadStoreSignExtendedByteHalfword(u16 instruction)
         if (h)
         {
             // LDSH
-            std::tie(val, readCycles) = ReadMemory(addr, AccessSize::HALFWORD);
+            std::tie(val, readCycles) = ReadMemory<AccessSize::HALFWORD>(addr);
             val = SignExtend<i32, 15>(val);
         }
         else
         {
             // LDSB
-            std::tie(val, readCycles) = ReadMemory(addr, AccessSize::BYTE);
+            std::tie(val, readCycles) = ReadMemory<AccessSize::BYTE>(addr);
             val = SignExtend<i32, 7>(val);
         }
 
@@ -580,7 +574,7 @@ void ARM7TDMI::ExecuteLoadStoreSignExtendedByteHalfword(u16 instruction)
         if (h)
         {
             // LDRH
-            auto [val, readCycles] = ReadMemory(addr, AccessSize::HALFWORD);
+            auto [val, readCycles] = ReadMemory<AccessSize::HALFWORD>(addr);
             scheduler_.Step(readCycles);
 
             if (addr & 0x01)
@@ -595,7 +589,7 @@ void ARM7TDMI::ExecuteLoadStoreSignExtendedByteHalfword(u16 instruction)
             // STRH
             load = false;
             u32 val = registers_.ReadRegister(flags.Rd);
-            int writeCycles = WriteMemory(addr, val, AccessSize::HALFWORD);
+            int writeCycles = WriteMemory<AccessSize::HALFWORD>(addr, val);
             scheduler_.Step(writeCycles);
         }
     }
@@ -610,7 +604,7 @@ void ARM7TDMI::ExecutePCRelativeLoad(u16 instruction)
 {
     auto flags = std::bit_cast<PCRelativeLoad::Flags>(instruction);
     u32 addr = (registers_.GetPC() & 0xFFFF'FFFC) + (flags.Word8 << 2);
-    auto [val, readCycles] = ReadMemory(addr, AccessSize::WORD);
+    auto [val, readCycles] = ReadMemory<AccessSize::WORD>(addr);
     scheduler_.Step(readCycles);
 
     if (addr & 0x03)
@@ -22,6 +22,7 @@ GamePak::GamePak(fs::path romPath, fs::path saveDir, EventScheduler& scheduler,
     systemControl_(systemControl)
 {
     title_ = "";
+    gameCode_ = "";
     gamePakLoaded_ = false;
     containsEeprom_ = false;
 
@@ -71,6 +72,7 @@ GamePak::GamePak(fs::path romPath, fs::path saveDir, EventScheduler& scheduler,
     }
 
     title_ = titleStream.str();
+    gameCode_.assign(reinterpret_cast<char const*>(&ROM_[0xAC]), 4);
 
     // Determine backup type and load save file if present
     auto backupType = DetectBackupType();
@@ -107,11 +109,12 @@ GamePak::GamePak(fs::path romPath, fs::path saveDir, EventScheduler& scheduler,
     gamePakLoaded_ = true;
 }
 
-MemReadData GamePak::ReadMem(u32 addr, AccessSize length)
+template <AccessSize Length>
+MemReadData GamePak::ReadMem(u32 addr)
 {
     if (backupMedia_ && backupMedia_->IsBackupMediaAccess(addr))
     {
-        return backupMedia_->ReadMem(addr, length);
+        return backupMedia_->ReadMem(addr, Length);
     }
 
     WaitStateRegion region;
@@ -134,11 +137,22 @@ MemReadData GamePak::ReadMem(u32 addr, AccessSize length)
             return {1, 0, true};
     }
 
-    if ((addr - GAMEPAK_ROM_ADDR_MIN) >= ROM_.size())
+    if (((addr - GAMEPAK_ROM_ADDR_MIN) + static_cast<u32>(Length)) > ROM_.size())
     {
         return {1, 0, true};
     }
 
+    int cycles = AccessCycles(addr, Length, region);
+    u32 val = ReadMemoryBlockUnchecked(ROM_, addr, GAMEPAK_ROM_ADDR_MIN, Length);
+    return {cycles, val, false};
+}
+
+template MemReadData GamePak::ReadMem<AccessSize::BYTE>(u32);
+template MemReadData GamePak::ReadMem<AccessSize::HALFWORD>(u32);
+template MemReadData GamePak::ReadMem<AccessSize::WORD>(u32);
+
+int GamePak::AccessCycles(u32 addr, AccessSize length, WaitStateRegion region)
+{
     int cycles = 1;
     bool sequential = addr == nextSequentialAddr_;
     u64 currentCycle = scheduler_.GetTotalElapsedCycles();
@@ -176,25 +190,29 @@ MemReadData GamePak::ReadMem(u32 addr, AccessSize length)
     nextSequentialAddr_ = addr + static_cast<u8>(length);
     cycles += waitStates;
     lastReadCompletionCycle_ = currentCycle + cycles;
-
-    u32 val = ReadMemoryBlock(ROM_, addr, GAMEPAK_ROM_ADDR_MIN, length);
-    return {cycles, val, false};
+    return cycles;
 }
 
-int GamePak::WriteMem(u32 addr, u32 val, AccessSize length)
+template <AccessSize Length>
+int GamePak::WriteMem(u32 addr, u32 val)
 {
     if (backupMedia_ && backupMedia_->IsBackupMediaAccess(addr))
     {
-        return backupMedia_->WriteMem(addr, val, length);
+        return backupMedia_->WriteMem(addr, val, Length);
     }
 
     return 1;
 }
 
-MemReadData GamePak::ReadUnloadedGamePakMem(u32 addr, AccessSize length)
+template int GamePak::WriteMem<AccessSize::BYTE>(u32, u32);
+template int GamePak::WriteMem<AccessSize::HALFWORD>(u32, u32);
+template int GamePak::WriteMem<AccessSize::WORD>(u32, u32);
+
+template <AccessSize Length>
+MemReadData GamePak::ReadUnloadedGamePakMem(u32 addr)
 {
     u32 val = 0;
-    size_t count = static_cast<size_t>(length);
+    size_t count = static_cast<size_t>(Length);
     u32 currAddr = addr + count - 1;
 
     while (count > 0)
@@ -207,6 +225,10 @@ MemReadData GamePak::ReadUnloadedGamePakMem(u32 addr, AccessSize length)
     return {1, val, false};
 }
 
+template MemReadData GamePak::ReadUnloadedGamePakMem<AccessSize::BYTE>(u32);
+template MemReadData GamePak::ReadUnloadedGamePakMem<AccessSize::HALFWORD>(u32);
+template MemReadData GamePak::ReadUnloadedGamePakMem<AccessSize::WORD>(u32);
+
 int GamePak::SetEepromIndex(u16 index, u8 indexSize)
 {
     if (containsEeprom_)
@@ -33,7 +33,7 @@ DmaManager::DmaManager(ReadMemCallback readMem,
     videoCapture_.fill(false);
     active_ = false;
 
-    scheduler_.RegisterEvent(EventType::DmaComplete, [this](int extraCycles){ this->EndDma(extraCycles); });
+    scheduler_.RegisterEvent(EventType::DmaComplete, {&DmaManager::EndDma, *this});
 }
 
 void DmaManager::ConnectGamePak(cartridge::GamePak* gamePakPtr)
@@ -1,11 +1,16 @@
 #include <GBA/include/GameBoyAdvance.hpp>
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <span>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <GBA/include/APU/APU.hpp>
 #include <GBA/include/BIOS/BIOSManager.hpp>
@@ -36,6 +41,16 @@ u32 ForceAlignAddress(u32 addr, AccessSize length)
 
     return addr;
 }
+
+/// @brief Identifies a file as an AdvancedBoy save state ("ADVBOYSS" when read as ASCII in little-endian byte order).
+constexpr u64 SAVE_STATE_MAGIC = 0x5353'594F'4256'4441;
+
+/// @brief Version of the save state layout. Increment whenever anything that gets serialized is added, removed, or reordered.
+constexpr u32 SAVE_STATE_VERSION = 1;
+
+/// @brief Host integer type that holds exactly one bus access of a given size.
+template <AccessSize Length>
+using AccessType = std::conditional_t<Length == AccessSize::BYTE, u8, std::conditional_t<Length == AccessSize::HALFWORD, u16, u32>>;
 }
 
 GameBoyAdvance::GameBoyAdvance(fs::path biosPath,
@@ -49,13 +64,28 @@ GameBoyAdvance::GameBoyAdvance(fs::path biosPath,
     systemControl_(scheduler_),
     apu_(clockMgr_, scheduler_),
     biosMgr_(biosPath, {&cpu::ARM7TDMI::GetPC, cpu_}),
-    cpu_({&GameBoyAdvance::ReadMem, *this}, {&GameBoyAdvance::WriteMem, *this}, scheduler_, skipBiosIntro),
+    cpu_({{&GameBoyAdvance::Read<AccessSize::BYTE>, *this},
+          {&GameBoyAdvance::Read<AccessSize::HALFWORD>, *this},
+          {&GameBoyAdvance::Read<AccessSize::WORD>, *this},
+          {&GameBoyAdvance::Write<AccessSize::BYTE>, *this},
+          {&GameBoyAdvance::Write<AccessSize::HALFWORD>, *this},
+          {&GameBoyAdvance::Write<AccessSize::WORD>, *this}},
+         {&GameBoyAdvance::FetchInstruction, *this},
+         {&GameBoyAdvance::CheckIdleLoop, *this},
+         {&GameBoyAdvance::ProtectCode, *this},
+         scheduler_,
+         skipBiosIntro || biosMgr_.UsingBuiltInBios()),
     dmaMgr_({&GameBoyAdvance::ReadMem, *this}, {&GameBoyAdvance::WriteMem, *this}, scheduler_, systemControl_),
     keypad_(systemControl_),
     ppu_(scheduler_, systemControl_),
     timerMgr_(scheduler_, systemControl_),
     gamePak_(nullptr),
     lastSuccessfulFetch_(0),
+    fetchRegion_({0, 0, nullptr, 1, 1, false, WaitStateRegion::ZERO}),
+    batchInterrupted_(false),
+    idleLoop_(),
+    idleLoopSkipping_(true),
+    idleCyclesSkipped_(0),
     breakpointCycle_(U64_MAX),
     breakOnVBlank_(false),
     hitVBlank_(false),
@@ -67,6 +97,9 @@ GameBoyAdvance::GameBoyAdvance(fs::path biosPath,
         return;
     }
 
+    cpu_.SetHleBios(biosMgr_.UsingBuiltInBios());
+    cpu_.SetBuiltInBios(biosMgr_.UsingBuiltInBios());
+
     if (!romPath.empty() && fs::exists(romPath))
     {
         gamePak_ = std::make_unique<cartridge::GamePak>(romPath, saveDir, scheduler_, systemControl_);
@@ -80,13 +113,15 @@ GameBoyAdvance::GameBoyAdvance(fs::path biosPath,
     dmaMgr_.ConnectGamePak(gamePak_.get());
     EWRAM_.fill(std::byte{0});
     IWRAM_.fill(std::byte{0});
-
-    scheduler_.RegisterEvent(EventType::VBlank, [this](int extraCycles){ this->VBlank(extraCycles); });
-    scheduler_.RegisterEvent(EventType::HBlank, [this](int extraCycles){ this->HBlank(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Timer0Overflow, [this](int extraCycles){ this->Timer0Overflow(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Timer1Overflow, [this](int extraCycles){ this->Timer1Overflow(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Timer2Overflow, [this](int extraCycles){ this->Timer2Overflow(extraCycles); });
-    scheduler_.RegisterEvent(EventType::Timer3Overflow, [this](int extraCycles){ this->Timer3Overflow(extraCycles); });
+    InitializePageTables();
+    InitializeIOHandlers();
+
+    scheduler_.RegisterEvent(EventType::VBlank, {&GameBoyAdvance::VBlank, *this});
+    scheduler_.RegisterEvent(EventType::HBlank, {&GameBoyAdvance::HBlank, *this});
+    scheduler_.RegisterEvent(EventType::Timer0Overflow, {&GameBoyAdvance::Timer0Overflow, *this});
+    scheduler_.RegisterEvent(EventType::Timer1Overflow, {&GameBoyAdvance::Timer1Overflow, *this});
+    scheduler_.RegisterEvent(EventType::Timer2Overflow, {&GameBoyAdvance::Timer2Overflow, *this});
+    scheduler_.RegisterEvent(EventType::Timer3Overflow, {&GameBoyAdvance::Timer3Overflow, *this});
 }
 
 GameBoyAdvance::~GameBoyAdvance()
@@ -99,6 +134,8 @@ GameBoyAdvance::~GameBoyAdvance()
 
 void GameBoyAdvance::Serialize(std::ofstream& saveState) const
 {
+    SerializeTrivialType(SAVE_STATE_MAGIC);
+    SerializeTrivialType(SAVE_STATE_VERSION);
     scheduler_.Serialize(saveState);
     systemControl_.Serialize(saveState);
     apu_.Serialize(saveState);
@@ -119,8 +156,18 @@ void GameBoyAdvance::Serialize(std::ofstream& saveState) const
     SerializeTrivialType(lastSuccessfulFetch_);
 }
 
-void GameBoyAdvance::Deserialize(std::ifstream& saveState)
+bool GameBoyAdvance::Deserialize(std::ifstream& saveState)
 {
+    u64 magic = 0;
+    u32 version = 0;
+    DeserializeTrivialType(magic);
+    DeserializeTrivialType(version);
+
+    if (saveState.fail() || (magic != SAVE_STATE_MAGIC) || (version != SAVE_STATE_VERSION))
+    {
+        return false;
+    }
+
     scheduler_.Deserialize(saveState);
     systemControl_.Deserialize(saveState);
     apu_.Deserialize(saveState);
@@ -139,6 +186,10 @@ void GameBoyAdvance::Deserialize(std::ifstream& saveState)
     DeserializeArray(EWRAM_);
     DeserializeArray(IWRAM_);
     DeserializeTrivialType(lastSuccessfulFetch_);
+
+    // Loading a state discards the CPU's decoded block cache, so work RAM no longer needs its writes reported.
+    InitializePageTables();
+    return true;
 }
 
 void GameBoyAdvance::Run()
@@ -187,6 +238,10 @@ void GameBoyAdvance::StepFrame()
         {
             scheduler_.FireNextEvent();
         }
+        else if (breakpoints_.empty())
+        {
+            RunCpuBatch();
+        }
         else
         {
             if (EncounteredBreakpoint())
@@ -204,6 +259,42 @@ void GameBoyAdvance::StepFrame()
     breakOnVBlank_ = false;
 }
 
+void GameBoyAdvance::SetCpuClockSpeed(u32 clockSpeed)
+{
+    clockMgr_.SetCpuClockSpeed(clockSpeed);
+
+    if (ppu_.GetFrameSkipMode() == graphics::FrameSkipMode::Auto)
+    {
+        SetFrameSkip(graphics::FrameSkipMode::Auto);
+    }
+}
+
+void GameBoyAdvance::SetCpuBackend(cpu::CpuBackend backend)
+{
+    // Switching backends empties the decoded block cache, so none of work RAM needs its writes reported anymore.
+    cpu_.SetBackend(backend);
+    InitializePageTables();
+}
+
+void GameBoyAdvance::SetFrameSkip(graphics::FrameSkipMode mode, u8 framesToSkip)
+{
+    if (mode == graphics::FrameSkipMode::Auto)
+    {
+        u32 speedMultiplier = clockMgr_.GetCpuClockSpeed() / cpu::CPU_FREQUENCY_HZ;
+        framesToSkip = (speedMultiplier == 0) ? 0 : std::min<u32>(speedMultiplier - 1, U8_MAX);
+    }
+
+    ppu_.SetFrameSkip(mode, framesToSkip);
+}
+
+void GameBoyAdvance::SetIdleLoopSkippingDisabledGameCodes(std::unordered_set<std::string> const& gameCodes)
+{
+    if (gamePak_)
+    {
+        idleLoopSkipping_ = !gameCodes.contains(gamePak_->GetGameCode());
+    }
+}
+
 bool GameBoyAdvance::MainLoop(size_t samples)
 {
     apu_.ClearSampleCounter();
@@ -214,6 +305,10 @@ bool GameBoyAdvance::MainLoop(size_t samples)
         {
             scheduler_.FireNextEvent();
         }
+        else if (breakpoints_.empty())
+        {
+            RunCpuBatch();
+        }
         else
         {
             if (EncounteredBreakpoint())
@@ -229,41 +324,176 @@ bool GameBoyAdvance::MainLoop(size_t samples)
     return false;
 }
 
+void GameBoyAdvance::RunCpuBatch()
+{
+    u64 deadline = scheduler_.GetNextEventCycle();
+    bool irq = systemControl_.IrqPending();
+    batchInterrupted_ = false;
+    idleLoop_.Valid = false;
+    idleLoop_.Deadline = idleLoopSkipping_ ? deadline : 0;
+
+    do
+    {
+        cpu_.Step(irq);
+    }
+    while (!batchInterrupted_ && (scheduler_.GetTotalElapsedCycles() < deadline));
+
+    idleLoop_.Deadline = 0;
+}
+
+void GameBoyAdvance::CheckIdleLoop()
+{
+    u64 currentCycle = scheduler_.GetTotalElapsedCycles();
+
+    if (currentCycle >= idleLoop_.Deadline)
+    {
+        return;
+    }
+
+    auto registers = cpu_.GetRegisterSnapshot();
+    auto prefetch = gamePak_ ? gamePak_->GetPrefetchState() : cartridge::GamePak::PrefetchState{};
+
+    if (idleLoop_.Valid && !idleLoop_.SideEffects && (idleLoop_.Registers == registers) && (idleLoop_.Prefetch == prefetch))
+    {
+        // Only skip iterations that finish before the deadline, so the event still fires partway through the same iteration.
+        u64 iterationCycles = currentCycle - idleLoop_.Cycle;
+        u64 iterations = (idleLoop_.Deadline - currentCycle - 1) / iterationCycles;
+        iterations = std::min(iterations, static_cast<u64>(std::numeric_limits<int>::max()) / iterationCycles);
+        u64 skippedCycles = iterations * iterationCycles;
+
+        if (skippedCycles > 0)
+        {
+            scheduler_.Step(static_cast<int>(skippedCycles));
+
+            if (gamePak_)
+            {
+                gamePak_->SkipCycles(skippedCycles);
+            }
+
+            idleCyclesSkipped_ += skippedCycles;
+            currentCycle += skippedCycles;
+        }
+    }
+
+    idleLoop_.Registers = registers;
+    idleLoop_.Prefetch = prefetch;
+    idleLoop_.Cycle = currentCycle;
+    idleLoop_.Valid = true;
+    idleLoop_.SideEffects = false;
+}
+
 ///---------------------------------------------------------------------------------------------------------------------------------
 /// Bus functionality
 ///---------------------------------------------------------------------------------------------------------------------------------
 
+void GameBoyAdvance::InitializePageTables()
+{
+    readPageTable_.fill({nullptr, 0, 0, 0});
+    writePageTable_.fill({nullptr, 0, 0, 0});
+
+    // Work RAM and all of its mirrors can be both read and written directly.
+    auto mapWorkRAM = [this](u32 regionMin, std::span<std::byte> memory, u8 halfwordCycles, u8 wordCycles)
+    {
+        for (u32 addr = regionMin; addr < (regionMin + (16 * MiB)); addr += PAGE_SIZE)
+        {
+            u32 offset = (addr - regionMin) % memory.size();
+            readPageTable_[addr >> PAGE_TABLE_SHIFT] = {memory.data() + offset, PAGE_SIZE - 1, halfwordCycles, wordCycles};
+            writePageTable_[addr >> PAGE_TABLE_SHIFT] = {memory.data() + offset, PAGE_SIZE - 1, halfwordCycles, wordCycles};
+        }
+    };
+
+    mapWorkRAM(EWRAM_ADDR_MIN, EWRAM_, 3, 6);
+    mapWorkRAM(IWRAM_ADDR_MIN, IWRAM_, 1, 1);
+
+    // PRAM and OAM are smaller than a page, so each entry covers several mirrors.
+
+    auto pram = ppu_.GetPRAM();
+    auto oam = ppu_.GetOAM();
+    auto vram = ppu_.GetVRAM();
+
+    for (u32 addr = PRAM_ADDR_MIN; addr < (PRAM_ADDR_MIN + (16 * MiB)); addr += PAGE_SIZE)
+    {
+        readPageTable_[addr >> PAGE_TABLE_SHIFT] = {pram.data(), static_cast<u32>(pram.size() - 1), 1, 2};
+    }
+
+    for (u32 addr = OAM_ADDR_MIN; addr < (OAM_ADDR_MIN + (16 * MiB)); addr += PAGE_SIZE)
+    {
+        readPageTable_[addr >> PAGE_TABLE_SHIFT] = {oam.data(), static_cast<u32>(oam.size() - 1), 1, 1};
+    }
+
+    // VRAM mirrors every 128KiB, and the last 32KiB of each mirror maps to the 32KiB of OBJ tiles before it.
+    for (u32 addr = VRAM_ADDR_MIN; addr < (VRAM_ADDR_MIN + (16 * MiB)); addr += PAGE_SIZE)
+    {
+        u32 offset = (addr - VRAM_ADDR_MIN) % (128 * KiB);
+
+        if (offset >= vram.size())
+        {
+            offset -= (32 * KiB);
+        }
+
+        readPageTable_[addr >> PAGE_TABLE_SHIFT] = {vram.data() + offset, PAGE_SIZE - 1, 1, 2};
+    }
+}
+
 std::pair<u32, int> GameBoyAdvance::ReadMem(u32 addr, AccessSize length)
 {
-    addr = ForceAlignAddress(addr, length);
+    switch (length)
+    {
+        case AccessSize::BYTE:
+            return Read<AccessSize::BYTE>(addr);
+        case AccessSize::HALFWORD:
+            return Read<AccessSize::HALFWORD>(addr);
+        case AccessSize::WORD:
+        default:
+            return Read<AccessSize::WORD>(addr);
+    }
+}
+
+template <AccessSize Length>
+std::pair<u32, int> GameBoyAdvance::Read(u32 addr)
+{
+    addr = ForceAlignAddress(addr, Length);
+    u32 pageIndex = addr >> PAGE_TABLE_SHIFT;
+
+    if ((pageIndex < PAGE_TABLE_SIZE) && (readPageTable_[pageIndex].Data != nullptr))
+    {
+        auto const& entry = readPageTable_[pageIndex];
+        u32 val = MemCpyInit<AccessType<Length>>(entry.Data + (addr & entry.Mask));
+        int cycles = (Length == AccessSize::WORD) ? entry.WordCycles : entry.HalfwordCycles;
+        lastSuccessfulFetch_ = val;
+        return {val, cycles};
+    }
+
     MemReadData readData;
     auto page = GetMemPage(addr);
 
     switch (page)
     {
         case Page::BIOS:
-            readData = biosMgr_.ReadMem(addr, length);
+            readData = biosMgr_.ReadMem(addr, Length);
             break;
         case Page::EWRAM:
-            readData = ReadEWRAM(addr, length);
+            readData = ReadEWRAM(addr, Length);
             break;
         case Page::IWRAM:
-            readData = ReadIWRAM(addr, length);
+            readData = ReadIWRAM(addr, Length);
             break;
         case Page::IO:
-            readData = ReadIO(addr, length);
+            readData = ReadIO(addr, Length);
             break;
         case Page::PRAM:
-            readData = ppu_.ReadPRAM(addr, length);
+            readData = ppu_.ReadPRAM<Length>(addr);
             break;
         case Page::VRAM:
-            readData = ppu_.ReadVRAM(addr, length);
+            readData = ppu_.ReadVRAM<Length>(addr);
             break;
         case Page::OAM:
-            readData = ppu_.ReadOAM(addr, length);
+            readData = ppu_.ReadOAM<Length>(addr);
             break;
         case Page::GAMEPAK_MIN ... Page::GAMEPAK_MAX:
-            readData = gamePak_ ? gamePak_->ReadMem(addr, length) : cartridge::GamePak::ReadUnloadedGamePakMem(addr, length);
+            // Reading EEPROM advances its read index.
+            idleLoop_.SideEffects |= (addr >= 0x0D00'0000);
+            readData = gamePak_ ? gamePak_->ReadMem<Length>(addr) : cartridge::GamePak::ReadUnloadedGamePakMem<Length>(addr);
             break;
         case Page::INVALID:
         default:
@@ -284,37 +514,139 @@ std::pair<u32, int> GameBoyAdvance::ReadMem(u32 addr, AccessSize length)
     return {readData.Value, readData.Cycles};
 }
 
-int GameBoyAdvance::WriteMem(u32 addr, u32 val, AccessSize length)
+std::pair<u32, int> GameBoyAdvance::FetchInstruction(u32 addr, AccessSize length)
 {
     addr = ForceAlignAddress(addr, length);
+
+    if ((addr - fetchRegion_.Start) >= fetchRegion_.Size)
+    {
+        UpdateFetchRegion(addr);
+
+        if ((addr - fetchRegion_.Start) >= fetchRegion_.Size)
+        {
+            return ReadMem(addr, length);
+        }
+    }
+
+    u32 offset = addr - fetchRegion_.Start;
+    u32 val;
+    int cycles;
+
+    if (length == AccessSize::WORD)
+    {
+        val = MemCpyInit<u32>(fetchRegion_.Data + offset);
+        cycles = fetchRegion_.WordCycles;
+    }
+    else
+    {
+        val = MemCpyInit<u16>(fetchRegion_.Data + offset);
+        cycles = fetchRegion_.HalfwordCycles;
+    }
+
+    if (fetchRegion_.GamePak)
+    {
+        cycles = gamePak_->AccessCycles(GAMEPAK_ROM_ADDR_MIN + offset, length, fetchRegion_.GamePakRegion);
+    }
+
+    lastSuccessfulFetch_ = val;
+    return {val, cycles};
+}
+
+void GameBoyAdvance::UpdateFetchRegion(u32 addr)
+{
+    // BIOS fetches update BIOS read protection, and fetches from anywhere else besides IWRAM, EWRAM, and GamePak ROM are rare
+    // enough that they always go through ReadMem. Wait state 2 ROM is skipped since EEPROM can be mapped into it.
+    fetchRegion_ = {0, 0, nullptr, 1, 1, false, WaitStateRegion::ZERO};
+
+    switch (GetMemPage(addr))
+    {
+        case Page::EWRAM:
+        {
+            u32 size = EWRAM_.size();
+            fetchRegion_ = {addr & ~(size - 1), size, EWRAM_.data(), 3, 6, false, WaitStateRegion::ZERO};
+            break;
+        }
+        case Page::IWRAM:
+        {
+            u32 size = IWRAM_.size();
+            fetchRegion_ = {addr & ~(size - 1), size, IWRAM_.data(), 1, 1, false, WaitStateRegion::ZERO};
+            break;
+        }
+        case Page::GAMEPAK_MIN ... Page::GAMEPAK_MAX:
+        {
+            if (gamePak_ && (addr < (GAMEPAK_ROM_ADDR_MIN + (64 * MiB))))
+            {
+                auto rom = gamePak_->GetROM();
+                bool waitState0 = addr < (GAMEPAK_ROM_ADDR_MIN + (32 * MiB));
+                u32 start = waitState0 ? GAMEPAK_ROM_ADDR_MIN : (GAMEPAK_ROM_ADDR_MIN + (32 * MiB));
+                auto region = waitState0 ? WaitStateRegion::ZERO : WaitStateRegion::ONE;
+                fetchRegion_ = {start, static_cast<u32>(rom.size() & ~0x03), rom.data(), 0, 0, true, region};
+            }
+
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+int GameBoyAdvance::WriteMem(u32 addr, u32 val, AccessSize length)
+{
+    switch (length)
+    {
+        case AccessSize::BYTE:
+            return Write<AccessSize::BYTE>(addr, val);
+        case AccessSize::HALFWORD:
+            return Write<AccessSize::HALFWORD>(addr, val);
+        case AccessSize::WORD:
+        default:
+            return Write<AccessSize::WORD>(addr, val);
+    }
+}
+
+template <AccessSize Length>
+int GameBoyAdvance::Write(u32 addr, u32 val)
+{
+    idleLoop_.SideEffects = true;
+    addr = ForceAlignAddress(addr, Length);
+    u32 pageIndex = addr >> PAGE_TABLE_SHIFT;
+
+    if ((pageIndex < PAGE_TABLE_SIZE) && (writePageTable_[pageIndex].Data != nullptr))
+    {
+        auto const& entry = writePageTable_[pageIndex];
+        auto sizedVal = static_cast<AccessType<Length>>(val);
+        std::memcpy(entry.Data + (addr & entry.Mask), &sizedVal, sizeof(sizedVal));
+        return (Length == AccessSize::WORD) ? entry.WordCycles : entry.HalfwordCycles;
+    }
+
     int cycles = 1;
     auto page = GetMemPage(addr);
 
     switch (page)
     {
         case Page::BIOS:
-            cycles = biosMgr_.WriteMem(addr, val, length);
+            cycles = biosMgr_.WriteMem(addr, val, Length);
             break;
         case Page::EWRAM:
-            cycles = WriteEWRAM(addr, val, length);
+            cycles = WriteEWRAM(addr, val, Length);
             break;
         case Page::IWRAM:
-            cycles = WriteIWRAM(addr, val, length);
+            cycles = WriteIWRAM(addr, val, Length);
             break;
         case Page::IO:
-            cycles = WriteIO(addr, val, length);
+            cycles = WriteIO(addr, val, Length);
             break;
         case Page::PRAM:
-            cycles = ppu_.WritePRAM(addr, val, length);
+            cycles = ppu_.WritePRAM<Length>(addr, val);
             break;
         case Page::VRAM:
-            cycles = ppu_.WriteVRAM(addr, val, length);
+            cycles = ppu_.WriteVRAM<Length>(addr, val);
             break;
         case Page::OAM:
-            cycles = ppu_.WriteOAM(addr, val, length);
+            cycles = ppu_.WriteOAM<Length>(addr, val);
             break;
         case Page::GAMEPAK_MIN ... Page::GAMEPAK_MAX:
-            cycles = gamePak_ ? gamePak_->WriteMem(addr, val, length) : 1;
+            cycles = gamePak_ ? gamePak_->WriteMem<Length>(addr, val) : 1;
             break;
         case Page::INVALID:
         default:
@@ -332,7 +664,7 @@ MemReadData GameBoyAdvance::ReadEWRAM(u32 addr, AccessSize length)
         addr = StandardMirroredAddress(addr, EWRAM_ADDR_MIN, EWRAM_ADDR_MAX);
     }
 
-    u32 val = ReadMemoryBlock(EWRAM_, addr, EWRAM_ADDR_MIN, length);
+    u32 val = ReadMemoryBlockUnchecked(EWRAM_, addr, EWRAM_ADDR_MIN, length);
     int cycles = (length == AccessSize::WORD) ? 6 : 3;
     return {cycles, val, false};
 }
@@ -344,7 +676,8 @@ int GameBoyAdvance::WriteEWRAM(u32 addr, u32 val, AccessSize length)
         addr = StandardMirroredAddress(addr, EWRAM_ADDR_MIN, EWRAM_ADDR_MAX);
     }
 
-    WriteMemoryBlock(EWRAM_, addr, EWRAM_ADDR_MIN, val, length);
+    WriteMemoryBlockUnchecked(EWRAM_, addr, EWRAM_ADDR_MIN, val, length);
+    cpu_.InvalidateDecodedCode(addr);
     return (length == AccessSize::WORD) ? 6 : 3;
 }
 
@@ -355,7 +688,7 @@ MemReadData GameBoyAdvance::ReadIWRAM(u32 addr, AccessSize length)
         addr = StandardMirroredAddress(addr, IWRAM_ADDR_MIN, IWRAM_ADDR_MAX);
     }
 
-    u32 val = ReadMemoryBlock(IWRAM_, addr, IWRAM_ADDR_MIN, length);
+    u32 val = ReadMemoryBlockUnchecked(IWRAM_, addr, IWRAM_ADDR_MIN, length);
     return {1, val, false};
 }
 
@@ -366,96 +699,159 @@ int GameBoyAdvance::WriteIWRAM(u32 addr, u32 val, AccessSize length)
         addr = StandardMirroredAddress(addr, IWRAM_ADDR_MIN, IWRAM_ADDR_MAX);
     }
 
-    WriteMemoryBlock(IWRAM_, addr, IWRAM_ADDR_MIN, val, length);
+    WriteMemoryBlockUnchecked(IWRAM_, addr, IWRAM_ADDR_MIN, val, length);
+    cpu_.InvalidateDecodedCode(addr);
     return 1;
 }
 
+bool GameBoyAdvance::ProtectCode(u32 addr)
+{
+    // Cached code must be fetched from its canonical address so that the address a write is reported at identifies the blocks it
+    // touches. Unmapping a work RAM page from the write page table sends every write to it through WriteEWRAM or WriteIWRAM.
+    auto protectWorkRAM = [this](u32 addr, u32 regionMin, u32 regionSize)
+    {
+        if (writePageTable_[addr >> PAGE_TABLE_SHIFT].Data == nullptr)
+        {
+            return;
+        }
+
+        u32 offset = (addr - regionMin) & ~(PAGE_SIZE - 1);
+
+        for (u32 mirror = regionMin + offset; mirror < (regionMin + (16 * MiB)); mirror += regionSize)
+        {
+            writePageTable_[mirror >> PAGE_TABLE_SHIFT].Data = nullptr;
+        }
+    };
+
+    if ((addr >= EWRAM_ADDR_MIN) && (addr <= EWRAM_ADDR_MAX))
+    {
+        protectWorkRAM(addr, EWRAM_ADDR_MIN, EWRAM_.size());
+        return true;
+    }
+
+    if ((addr >= IWRAM_ADDR_MIN) && (addr <= IWRAM_ADDR_MAX))
+    {
+        protectWorkRAM(addr, IWRAM_ADDR_MIN, IWRAM_.size());
+        return true;
+    }
+
+    // GamePak ROM can't be written. Wait state 2 is skipped for the same reason as in UpdateFetchRegion.
+    return gamePak_ && (addr >= GAMEPAK_ROM_ADDR_MIN) && (addr < (GAMEPAK_ROM_ADDR_MIN + (64 * MiB))) &&
+           ((addr & ((32 * MiB) - 1)) < gamePak_->GetROM().size());
+}
+
+void GameBoyAdvance::InitializeIOHandlers()
+{
+    for (u32 addr = IO_ADDR_MIN; addr < (IO_ADDR_MIN + IO_HANDLER_RANGE); addr += 2)
+    {
+        IOReadHandler read = {&GameBoyAdvance::ReadUnmappedIO, *this};
+        IOWriteHandler write = {&GameBoyAdvance::WriteIgnoredIO, *this};
+
+        switch (addr)
+        {
+            case LCD_IO_ADDR_MIN ... LCD_IO_ADDR_MAX:
+                read = {&graphics::PPU::ReadReg, ppu_};
+                write = {&graphics::PPU::WriteReg, ppu_};
+                break;
+            case SOUND_IO_ADDR_MIN ... SOUND_IO_ADDR_MAX:
+                read = {&audio::APU::ReadReg, apu_};
+                write = {&audio::APU::WriteReg, apu_};
+                break;
+            case DMA_IO_ADDR_MIN ... DMA_IO_ADDR_MAX:
+                read = {&dma::DmaManager::ReadReg, dmaMgr_};
+                write = {&dma::DmaManager::WriteReg, dmaMgr_};
+                break;
+            case TIMER_0_ADDR_MIN ... TIMER_0_ADDR_MAX:
+                read = {&timers::TimerManager::ReadTimerReg<0>, timerMgr_};
+                write = {&timers::TimerManager::WriteTimerReg<0>, timerMgr_};
+                break;
+            case TIMER_1_ADDR_MIN ... TIMER_1_ADDR_MAX:
+                read = {&timers::TimerManager::ReadTimerReg<1>, timerMgr_};
+                write = {&timers::TimerManager::WriteTimerReg<1>, timerMgr_};
+                break;
+            case TIMER_2_ADDR_MIN ... TIMER_2_ADDR_MAX:
+                read = {&timers::TimerManager::ReadTimerReg<2>, timerMgr_};
+                write = {&timers::TimerManager::WriteTimerReg<2>, timerMgr_};
+                break;
+            case TIMER_3_ADDR_MIN ... TIMER_3_ADDR_MAX:
+                read = {&timers::TimerManager::ReadTimerReg<3>, timerMgr_};
+                write = {&timers::TimerManager::WriteTimerReg<3>, timerMgr_};
+                break;
+            case SERIAL_IO_1_ADDR_MIN ... SERIAL_IO_1_ADDR_MAX:
+            case SERIAL_IO_2_ADDR_MIN ... SERIAL_IO_2_ADDR_MAX:
+                read = {&GameBoyAdvance::ReadSerialIO, *this};
+                break;
+            case KEYPAD_IO_ADDR_MIN ... KEYPAD_IO_ADDR_MAX:
+                read = {&Keypad::ReadReg, keypad_};
+                write = {&Keypad::WriteReg, keypad_};
+                break;
+            case SYSTEM_CONTROL_IO_ADDR_MIN ... (IO_ADDR_MIN + IO_HANDLER_RANGE - 1):
+                read = {&SystemControl::ReadReg, systemControl_};
+                write = {&SystemControl::WriteReg, systemControl_};
+                break;
+            default:
+                break;
+        }
+
+        ioReadHandlers_[(addr - IO_ADDR_MIN) / 2] = read;
+        ioWriteHandlers_[(addr - IO_ADDR_MIN) / 2] = write;
+    }
+
+    // Registers that games poll in tight loops skip their component's checks for unused and write-only registers.
+    ioReadHandlers_[0x04 / 2] = {&graphics::PPU::ReadDispstatVcount, ppu_};
+    ioReadHandlers_[0x06 / 2] = {&graphics::PPU::ReadDispstatVcount, ppu_};
+    ioReadHandlers_[0x200 / 2] = {&SystemControl::ReadIEAndIF, systemControl_};
+    ioReadHandlers_[0x202 / 2] = {&SystemControl::ReadIEAndIF, systemControl_};
+}
+
 MemReadData GameBoyAdvance::ReadIO(u32 addr, AccessSize length)
 {
+    u32 offset = addr - IO_ADDR_MIN;
+
+    if (offset < IO_HANDLER_RANGE)
+    {
+        // Timer counters tick without any event firing, so a loop that reads one can't be assumed to be idle.
+        idleLoop_.SideEffects |= (addr >= TIMER_IO_ADDR_MIN) && (addr <= TIMER_IO_ADDR_MAX);
+        return ioReadHandlers_[offset / 2](addr, length);
+    }
+
     if ((addr > SYSTEM_CONTROL_IO_ADDR_MAX) && (((addr - 0x0400'0800) % (64 * KiB)) < 4))
     {
         // I/O registers are not mirrored, with the exception of 4000800h repeating every 64K.
         addr = 0x0400'0800 + ((addr - 0x0400'0800) % (64 * KiB));
     }
 
-    MemReadData readData;
-
-    switch (addr)
+    if (addr <= SYSTEM_CONTROL_IO_ADDR_MAX)
     {
-        case LCD_IO_ADDR_MIN ... LCD_IO_ADDR_MAX:
-            readData = ppu_.ReadReg(addr, length);
-            break;
-        case SOUND_IO_ADDR_MIN ... SOUND_IO_ADDR_MAX:
-            readData = apu_.ReadReg(addr, length);
-            break;
-        case DMA_IO_ADDR_MIN ... DMA_IO_ADDR_MAX:
-            readData = dmaMgr_.ReadReg(addr, length);
-            break;
-        case TIMER_IO_ADDR_MIN ... TIMER_IO_ADDR_MAX:
-            readData = timerMgr_.ReadReg(addr, length);
-            break;
-        case SERIAL_IO_1_ADDR_MIN ... SERIAL_IO_1_ADDR_MAX:
-            readData = {1, 0, false};
-            break;
-        case KEYPAD_IO_ADDR_MIN ... KEYPAD_IO_ADDR_MAX:
-            readData = keypad_.ReadReg(addr, length);
-            break;
-        case SERIAL_IO_2_ADDR_MIN ... SERIAL_IO_2_ADDR_MAX:
-            readData = {1, 0, false};
-            break;
-        case SYSTEM_CONTROL_IO_ADDR_MIN ... SYSTEM_CONTROL_IO_ADDR_MAX:
-            readData = systemControl_.ReadReg(addr, length);
-            break;
-        default:
-            readData = {1, 0, true};
-            break;
+        return systemControl_.ReadReg(addr, length);
     }
 
-    return readData;
+    return {1, 0, true};
 }
 
 int GameBoyAdvance::WriteIO(u32 addr, u32 val, AccessSize length)
 {
+    // Any IO write can change the state that RunCpuBatch assumes stays constant, so end the current batch after this instruction.
+    batchInterrupted_ = true;
+    u32 offset = addr - IO_ADDR_MIN;
+
+    if (offset < IO_HANDLER_RANGE)
+    {
+        return ioWriteHandlers_[offset / 2](addr, val, length);
+    }
+
     if ((addr > SYSTEM_CONTROL_IO_ADDR_MAX) && (((addr - 0x0400'0800) % (64 * KiB)) < 4))
     {
         // I/O registers are not mirrored, with the exception of 4000800h repeating every 64K.
         addr = 0x0400'0800 + ((addr - 0x0400'0800) % (64 * KiB));
     }
 
-    int cycles;
-
-    switch (addr)
+    if (addr <= SYSTEM_CONTROL_IO_ADDR_MAX)
     {
-        case LCD_IO_ADDR_MIN ... LCD_IO_ADDR_MAX:
-            cycles = ppu_.WriteReg(addr, val, length);
-            break;
-        case SOUND_IO_ADDR_MIN ... SOUND_IO_ADDR_MAX:
-            cycles = apu_.WriteReg(addr, val, length);
-            break;
-        case DMA_IO_ADDR_MIN ... DMA_IO_ADDR_MAX:
-            cycles = dmaMgr_.WriteReg(addr, val, length);
-            break;
-        case TIMER_IO_ADDR_MIN ... TIMER_IO_ADDR_MAX:
-            cycles = timerMgr_.WriteReg(addr, val, length);
-            break;
-        case SERIAL_IO_1_ADDR_MIN ... SERIAL_IO_1_ADDR_MAX:
-            cycles = 1;
-            break;
-        case KEYPAD_IO_ADDR_MIN ... KEYPAD_IO_ADDR_MAX:
-            cycles = keypad_.WriteReg(addr, val, length);
-            break;
-        case SERIAL_IO_2_ADDR_MIN ... SERIAL_IO_2_ADDR_MAX:
-            cycles = 1;
-            break;
-        case SYSTEM_CONTROL_IO_ADDR_MIN ... SYSTEM_CONTROL_IO_ADDR_MAX:
-            cycles = systemControl_.WriteReg(addr, val, length);
-            break;
-        default:
-            cycles = 1;
-            break;
+        return systemControl_.WriteReg(addr, val, length);
     }
 
-    return cycles;
+    return 1;
 }
 
 ///---------------------------------------------------------------------------------------------------------------------------------
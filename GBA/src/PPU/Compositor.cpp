@@ -0,0 +1,336 @@
+#include <GBA/include/PPU/Compositor.hpp>
+#include <algorithm>
+#include <GBA/include/Utilities/Types.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ADVANCEDBOY_X86_COMPOSITOR
+#include <immintrin.h>
+#endif
+
+namespace
+{
+/// @brief Blend the top two layers together.
+/// @param eva First target coefficient.
+/// @param evb Second target coefficient.
+/// @param targetA bgr555 value of first target.
+/// @param targetB bgr555 value of second target.
+/// @return Blended bgr555 value of the two pixels.
+inline u16 AlphaBlend(u16 eva, u16 evb, u16 targetA, u16 targetB)
+{
+    // Isolate individual r, g, and b intensities as 1.4 fixed point values
+    u16 redA = (targetA & 0x001F) << 4;
+    u16 redB = (targetB & 0x001F) << 4;
+    u16 greenA = (targetA & 0x03E0) >> 1;
+    u16 greenB = (targetB & 0x03E0) >> 1;
+    u16 blueA = (targetA & 0x7C00) >> 6;
+    u16 blueB = (targetB & 0x7C00) >> 6;
+
+    u16 red = ((eva * redA) + (evb * redB)) >> 8;
+    u16 green = ((eva * greenA) + (evb * greenB)) >> 8;
+    u16 blue = ((eva * blueA) + (evb * blueB)) >> 8;
+
+    red = std::min(static_cast<u16>(31), red);
+    green = std::min(static_cast<u16>(31), green);
+    blue = std::min(static_cast<u16>(31), blue);
+
+    return (blue << 10) | (green << 5) | red;
+}
+
+/// @brief Increase the brightness of the top layer.
+/// @param evy Brightness coefficient.
+/// @param target bgr555 value to increase brightness of.
+/// @return Increased brightness bgr555 value.
+inline u16 IncreaseBrightness(u16 evy, u16 target)
+{
+    // Isolate individual r, g, and b intensities as 1.4 fixed point values
+    u16 red = (target & 0x001F) << 4;
+    u16 green = (target & 0x03E0) >> 1;
+    u16 blue = (target & 0x7C00) >> 6;
+
+    red = (red + (((0x01F0 - red) * evy) >> 4)) >> 4;
+    green = (green + (((0x01F0 - green) * evy) >> 4)) >> 4;
+    blue = (blue + (((0x01F0 - blue) * evy) >> 4)) >> 4;
+
+    return (blue << 10) | (green << 5) | red;
+}
+
+/// @brief Decrease the brightness of the top layer.
+/// @param evy Brightness coefficient.
+/// @param target bgr555 value to decrease brightness of.
+/// @return Decreased brightness bgr555 value.
+inline u16 DecreaseBrightness(u16 evy, u16 target)
+{
+    // Isolate individual r, g, and b intensities as 1.4 fixed point values
+    u16 red = (target & 0x001F) << 4;
+    u16 green = (target & 0x03E0) >> 1;
+    u16 blue = (target & 0x7C00) >> 6;
+
+    red = (red - ((red * evy) >> 4)) >> 4;
+    green = (green - ((green * evy) >> 4)) >> 4;
+    blue = (blue - ((blue * evy) >> 4)) >> 4;
+
+    return (blue << 10) | (green << 5) | red;
+}
+
+#ifdef ADVANCEDBOY_X86_COMPOSITOR
+// The vectorized paths work on 5 bit intensities in 16 bit lanes. With the 1.4 fixed point scaling from the scalar functions
+// factored out, every effect becomes (a * x + b * y) >> 4 for intensities x and y, which never exceeds 992 and so can't overflow.
+// All three effects are computed for every dot and the result is selected with a mask built from that dot's effect.
+
+/// @brief Apply every special effect to one color channel of 8 dots and select the result based on each dot's effect.
+/// @param intensityA 5 bit intensities of the top layer.
+/// @param intensityB 5 bit intensities of the second layer.
+/// @param eva First target coefficient in every lane.
+/// @param evb Second target coefficient in every lane.
+/// @param evy Brightness coefficient in every lane.
+/// @param isBlend Mask of dots that are alpha blended.
+/// @param isIncrease Mask of dots that have their brightness increased.
+/// @param isDecrease Mask of dots that have their brightness decreased.
+/// @return 5 bit intensities after applying effects. Dots without an effect are 0.
+__attribute__((target("sse2")))
+inline __m128i ApplyEffectsSse2(__m128i intensityA,
+                                __m128i intensityB,
+                                __m128i eva,
+                                __m128i evb,
+                                __m128i evy,
+                                __m128i isBlend,
+                                __m128i isIncrease,
+                                __m128i isDecrease)
+{
+    __m128i const maxIntensity = _mm_set1_epi16(0x1F);
+
+    __m128i blended = _mm_add_epi16(_mm_mullo_epi16(eva, intensityA), _mm_mullo_epi16(evb, intensityB));
+    blended = _mm_min_epi16(_mm_srli_epi16(blended, 4), maxIntensity);
+
+    __m128i scaledA = _mm_slli_epi16(intensityA, 4);
+    __m128i increased = _mm_mullo_epi16(_mm_sub_epi16(maxIntensity, intensityA), evy);
+    increased = _mm_srli_epi16(_mm_add_epi16(scaledA, increased), 4);
+    __m128i decreased = _mm_srli_epi16(_mm_sub_epi16(scaledA, _mm_mullo_epi16(intensityA, evy)), 4);
+
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(isBlend, blended), _mm_and_si128(isIncrease, increased)),
+                        _mm_and_si128(isDecrease, decreased));
+}
+
+/// @brief Apply every special effect to one color channel of 16 dots and select the result based on each dot's effect.
+/// @param intensityA 5 bit intensities of the top layer.
+/// @param intensityB 5 bit intensities of the second layer.
+/// @param eva First target coefficient in every lane.
+/// @param evb Second target coefficient in every lane.
+/// @param evy Brightness coefficient in every lane.
+/// @param isBlend Mask of dots that are alpha blended.
+/// @param isIncrease Mask of dots that have their brightness increased.
+/// @param isDecrease Mask of dots that have their brightness decreased.
+/// @return 5 bit intensities after applying effects. Dots without an effect are 0.
+__attribute__((target("avx2")))
+inline __m256i ApplyEffectsAvx2(__m256i intensityA,
+                                __m256i intensityB,
+                                __m256i eva,
+                                __m256i evb,
+                                __m256i evy,
+                                __m256i isBlend,
+                                __m256i isIncrease,
+                                __m256i isDecrease)
+{
+    __m256i const maxIntensity = _mm256_set1_epi16(0x1F);
+
+    __m256i blended = _mm256_add_epi16(_mm256_mullo_epi16(eva, intensityA), _mm256_mullo_epi16(evb, intensityB));
+    blended = _mm256_min_epu16(_mm256_srli_epi16(blended, 4), maxIntensity);
+
+    __m256i scaledA = _mm256_slli_epi16(intensityA, 4);
+    __m256i increased = _mm256_mullo_epi16(_mm256_sub_epi16(maxIntensity, intensityA), evy);
+    increased = _mm256_srli_epi16(_mm256_add_epi16(scaledA, increased), 4);
+    __m256i decreased = _mm256_srli_epi16(_mm256_sub_epi16(scaledA, _mm256_mullo_epi16(intensityA, evy)), 4);
+
+    return _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(isBlend, blended), _mm256_and_si256(isIncrease, increased)),
+                           _mm256_and_si256(isDecrease, decreased));
+}
+#endif
+}
+
+namespace graphics
+{
+void CompositeScalar(u16 const* topColors,
+                     u16 const* bottomColors,
+                     SpecialEffect const* effects,
+                     BlendCoefficients coefficients,
+                     u16* output,
+                     size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        switch (effects[i])
+        {
+            case SpecialEffect::None:
+                output[i] = topColors[i];
+                break;
+            case SpecialEffect::AlphaBlending:
+                output[i] = AlphaBlend(coefficients.eva, coefficients.evb, topColors[i], bottomColors[i]);
+                break;
+            case SpecialEffect::BrightnessIncrease:
+                output[i] = IncreaseBrightness(coefficients.evy, topColors[i]);
+                break;
+            case SpecialEffect::BrightnessDecrease:
+                output[i] = DecreaseBrightness(coefficients.evy, topColors[i]);
+                break;
+        }
+    }
+}
+
+#ifdef ADVANCEDBOY_X86_COMPOSITOR
+__attribute__((target("sse2")))
+void CompositeSse2(u16 const* topColors,
+                   u16 const* bottomColors,
+                   SpecialEffect const* effects,
+                   BlendCoefficients coefficients,
+                   u16* output,
+                   size_t count)
+{
+    __m128i const intensityMask = _mm_set1_epi16(0x1F);
+    __m128i const eva = _mm_set1_epi16(coefficients.eva);
+    __m128i const evb = _mm_set1_epi16(coefficients.evb);
+    __m128i const evy = _mm_set1_epi16(coefficients.evy);
+    __m128i const blendEffect = _mm_set1_epi16(static_cast<u8>(SpecialEffect::AlphaBlending));
+    __m128i const increaseEffect = _mm_set1_epi16(static_cast<u8>(SpecialEffect::BrightnessIncrease));
+    __m128i const decreaseEffect = _mm_set1_epi16(static_cast<u8>(SpecialEffect::BrightnessDecrease));
+
+    size_t i = 0;
+
+    for (; (i + 8) <= count; i += 8)
+    {
+        __m128i top = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&topColors[i]));
+        __m128i bottom = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&bottomColors[i]));
+        __m128i effect = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(&effects[i])), _mm_setzero_si128());
+
+        __m128i isBlend = _mm_cmpeq_epi16(effect, blendEffect);
+        __m128i isIncrease = _mm_cmpeq_epi16(effect, increaseEffect);
+        __m128i isDecrease = _mm_cmpeq_epi16(effect, decreaseEffect);
+        __m128i hasEffect = _mm_or_si128(_mm_or_si128(isBlend, isIncrease), isDecrease);
+
+        __m128i red = ApplyEffectsSse2(_mm_and_si128(top, intensityMask),
+                                       _mm_and_si128(bottom, intensityMask),
+                                       eva, evb, evy, isBlend, isIncrease, isDecrease);
+        __m128i green = ApplyEffectsSse2(_mm_and_si128(_mm_srli_epi16(top, 5), intensityMask),
+                                         _mm_and_si128(_mm_srli_epi16(bottom, 5), intensityMask),
+                                         eva, evb, evy, isBlend, isIncrease, isDecrease);
+        __m128i blue = ApplyEffectsSse2(_mm_and_si128(_mm_srli_epi16(top, 10), intensityMask),
+                                        _mm_and_si128(_mm_srli_epi16(bottom, 10), intensityMask),
+                                        eva, evb, evy, isBlend, isIncrease, isDecrease);
+
+        __m128i composited = _mm_or_si128(_mm_or_si128(red, _mm_slli_epi16(green, 5)), _mm_slli_epi16(blue, 10));
+        __m128i result = _mm_or_si128(_mm_and_si128(hasEffect, composited), _mm_andnot_si128(hasEffect, top));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), result);
+    }
+
+    CompositeScalar(&topColors[i], &bottomColors[i], &effects[i], coefficients, &output[i], count - i);
+}
+
+__attribute__((target("avx2")))
+void CompositeAvx2(u16 const* topColors,
+                   u16 const* bottomColors,
+                   SpecialEffect const* effects,
+                   BlendCoefficients coefficients,
+                   u16* output,
+                   size_t count)
+{
+    __m256i const intensityMask = _mm256_set1_epi16(0x1F);
+    __m256i const eva = _mm256_set1_epi16(coefficients.eva);
+    __m256i const evb = _mm256_set1_epi16(coefficients.evb);
+    __m256i const evy = _mm256_set1_epi16(coefficients.evy);
+    __m256i const blendEffect = _mm256_set1_epi16(static_cast<u8>(SpecialEffect::AlphaBlending));
+    __m256i const increaseEffect = _mm256_set1_epi16(static_cast<u8>(SpecialEffect::BrightnessIncrease));
+    __m256i const decreaseEffect = _mm256_set1_epi16(static_cast<u8>(SpecialEffect::BrightnessDecrease));
+
+    size_t i = 0;
+
+    for (; (i + 16) <= count; i += 16)
+    {
+        __m256i top = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(&topColors[i]));
+        __m256i bottom = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(&bottomColors[i]));
+        __m256i effect = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&effects[i])));
+
+        __m256i isBlend = _mm256_cmpeq_epi16(effect, blendEffect);
+        __m256i isIncrease = _mm256_cmpeq_epi16(effect, increaseEffect);
+        __m256i isDecrease = _mm256_cmpeq_epi16(effect, decreaseEffect);
+        __m256i hasEffect = _mm256_or_si256(_mm256_or_si256(isBlend, isIncrease), isDecrease);
+
+        __m256i red = ApplyEffectsAvx2(_mm256_and_si256(top, intensityMask),
+                                       _mm256_and_si256(bottom, intensityMask),
+                                       eva, evb, evy, isBlend, isIncrease, isDecrease);
+        __m256i green = ApplyEffectsAvx2(_mm256_and_si256(_mm256_srli_epi16(top, 5), intensityMask),
+                                         _mm256_and_si256(_mm256_srli_epi16(bottom, 5), intensityMask),
+                                         eva, evb, evy, isBlend, isIncrease, isDecrease);
+        __m256i blue = ApplyEffectsAvx2(_mm256_and_si256(_mm256_srli_epi16(top, 10), intensityMask),
+                                        _mm256_and_si256(_mm256_srli_epi16(bottom, 10), intensityMask),
+                                        eva, evb, evy, isBlend, isIncrease, isDecrease);
+
+        __m256i composited = _mm256_or_si256(_mm256_or_si256(red, _mm256_slli_epi16(green, 5)), _mm256_slli_epi16(blue, 10));
+        __m256i result = _mm256_blendv_epi8(top, composited, hasEffect);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[i]), result);
+    }
+
+    CompositeSse2(&topColors[i], &bottomColors[i], &effects[i], coefficients, &output[i], count - i);
+}
+
+CompositeFunction SelectCompositeFunction()
+{
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CompositeAvx2;
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return CompositeSse2;
+    }
+
+    return CompositeScalar;
+}
+
+char const* SelectedCompositorName()
+{
+    CompositeFunction composite = SelectCompositeFunction();
+
+    if (composite == CompositeAvx2)
+    {
+        return "avx2";
+    }
+
+    if (composite == CompositeSse2)
+    {
+        return "sse2";
+    }
+
+    return "scalar";
+}
+#else
+void CompositeSse2(u16 const* topColors,
+                   u16 const* bottomColors,
+                   SpecialEffect const* effects,
+                   BlendCoefficients coefficients,
+                   u16* output,
+                   size_t count)
+{
+    CompositeScalar(topColors, bottomColors, effects, coefficients, output, count);
+}
+
+void CompositeAvx2(u16 const* topColors,
+                   u16 const* bottomColors,
+                   SpecialEffect const* effects,
+                   BlendCoefficients coefficients,
+                   u16* output,
+                   size_t count)
+{
+    CompositeScalar(topColors, bottomColors, effects, coefficients, output, count);
+}
+
+CompositeFunction SelectCompositeFunction()
+{
+    return CompositeScalar;
+}
+
+char const* SelectedCompositorName()
+{
+    return "scalar";
+}
+#endif
+}  // namespace graphics
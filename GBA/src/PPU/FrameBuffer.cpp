@@ -1,247 +1,162 @@
 #include <GBA/include/PPU/FrameBuffer.hpp>
 #include <algorithm>
 #include <array>
-#include <vector>
+#include <memory>
+#include <GBA/include/PPU/Compositor.hpp>
 #include <GBA/include/PPU/Registers.hpp>
 #include <GBA/include/Utilities/Types.hpp>
 
 namespace
 {
-/// @brief Blend the top two layers together.
-/// @param eva First target coefficient.
-/// @param evb Second target coefficient.
-/// @param targetA bgr555 value of first target.
-/// @param targetB bgr555 value of second target.
-/// @return Blended bgr555 value of the two pixels.
-inline u16 AlphaBlend(u16 eva, u16 evb, u16 targetA, u16 targetB)
+/// @brief Convert a scanline of BGR555 pixels to XRGB8888. Each channel is scaled by replicating its top bits into the low bits so
+///        that 0 maps to 0x00 and 31 maps to 0xFF. The fixed trip count and lack of branches let the compiler vectorize it.
+/// @param src BGR555 pixels to convert.
+/// @param dest Array to write XRGB8888 pixels to.
+void ConvertScanlineToXrgb8888(u16 const* src, u32* dest)
 {
-    // Isolate individual r, g, and b intensities as 1.4 fixed point values
-    u16 redA = (targetA & 0x001F) << 4;
-    u16 redB = (targetB & 0x001F) << 4;
-    u16 greenA = (targetA & 0x03E0) >> 1;
-    u16 greenB = (targetB & 0x03E0) >> 1;
-    u16 blueA = (targetA & 0x7C00) >> 6;
-    u16 blueB = (targetB & 0x7C00) >> 6;
-
-    u16 red = ((eva * redA) + (evb * redB)) >> 8;
-    u16 green = ((eva * greenA) + (evb * greenB)) >> 8;
-    u16 blue = ((eva * blueA) + (evb * blueB)) >> 8;
-
-    red = std::min(static_cast<u16>(31), red);
-    green = std::min(static_cast<u16>(31), green);
-    blue = std::min(static_cast<u16>(31), blue);
-
-    return (blue << 10) | (green << 5) | red;
-}
-
-/// @brief Increase the brightness of the top layer.
-/// @param evy Brightness coefficient.
-/// @param target bgr555 value to increase brightness of.
-/// @return Increased brightness bgr555 value.
-inline u16 IncreaseBrightness(u16 evy, u16 target)
-{
-    // Isolate individual r, g, and b intensities as 1.4 fixed point values
-    u16 red = (target & 0x001F) << 4;
-    u16 green = (target & 0x03E0) >> 1;
-    u16 blue = (target & 0x7C00) >> 6;
-
-    red = (red + (((0x01F0 - red) * evy) >> 4)) >> 4;
-    green = (green + (((0x01F0 - green) * evy) >> 4)) >> 4;
-    blue = (blue + (((0x01F0 - blue) * evy) >> 4)) >> 4;
-
-    return (blue << 10) | (green << 5) | red;
-}
-
-/// @brief Decrease the brightness of the top layer.
-/// @param evy Brightness coefficient.
-/// @param target bgr555 value to decrease brightness of.
-/// @return Decreased brightness bgr555 value.
-inline u16 DecreaseBrightness(u16 evy, u16 target)
-{
-    // Isolate individual r, g, and b intensities as 1.4 fixed point values
-    u16 red = (target & 0x001F) << 4;
-    u16 green = (target & 0x03E0) >> 1;
-    u16 blue = (target & 0x7C00) >> 6;
+    for (i16 i = 0; i < graphics::LCD_WIDTH; ++i)
+    {
+        u32 bgr555 = src[i];
+        u32 red = bgr555 & 0x1F;
+        u32 green = (bgr555 >> 5) & 0x1F;
+        u32 blue = (bgr555 >> 10) & 0x1F;
 
-    red = (red - ((red * evy) >> 4)) >> 4;
-    green = (green - ((green * evy) >> 4)) >> 4;
-    blue = (blue - ((blue * evy) >> 4)) >> 4;
+        red = (red << 3) | (red >> 2);
+        green = (green << 3) | (green >> 2);
+        blue = (blue << 3) | (blue >> 2);
 
-    return (blue << 10) | (green << 5) | red;
+        dest[i] = 0xFF00'0000 | (red << 16) | (green << 8) | blue;
+    }
 }
 }
 
 namespace graphics
 {
-bool Pixel::operator<(Pixel const& rhs) const
+FrameBuffer::FrameBuffer()
 {
-    if (transparent && !rhs.transparent)
+    for (auto& frameBuffer : frameBuffers_)
     {
-        return false;
+        frameBuffer.fill(0xFFFF);
     }
 
-    if (!transparent && rhs.transparent)
+    for (auto& colors : layerColors_)
     {
-        return true;
+        colors.fill(0);
     }
 
-    if (priority == rhs.priority)
+    for (auto& keys : layerKeys_)
     {
-        return source < rhs.source;
+        keys.fill(TRANSPARENT_KEY);
     }
 
-    return priority < rhs.priority;
-}
+    objSemiTransparent_.fill(false);
+    activeLayers_ = 0;
 
-FrameBuffer::FrameBuffer()
-{
-    for (auto& pixels : scanline_)
-    {
-        pixels.reserve(5);
-    }
-
-    for (auto& frameBuffer : frameBuffers_)
-    {
-        frameBuffer.fill(0xFFFF);
-    }
+    topColors_.fill(0);
+    bottomColors_.fill(0);
+    effects_.fill(SpecialEffect::None);
 
+    pixelFormat_ = PixelFormat::BGR555;
     activeBufferIndex_ = 0;
     pixelIndex_ = 0;
+    composite_ = SelectCompositeFunction();
 }
 
-void FrameBuffer::PushPixel(Pixel pixel, u8 dot)
-{
-    scanline_.at(dot).push_back(pixel);
-}
-
-void FrameBuffer::PushSpritePixels()
+void FrameBuffer::RenderScanline(u16 backdrop, bool forceBlank, BLDCNT bldcnt, BLDALPHA bldalpha, BLDY bldy)
 {
-    for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
+    if (forceBlank)
     {
-        if (spriteScanline_[dot].initialized)
-        {
-            scanline_[dot].push_back(spriteScanline_[dot]);
-        }
+        std::fill_n(&frameBuffers_[activeBufferIndex_].at(pixelIndex_), LCD_WIDTH, 0x7FFF);
+        activeLayers_ = 0;
+        FinishScanline();
+        return;
     }
-}
 
-void FrameBuffer::ClearSpritePixels()
-{
-    for (Pixel& pixel : spriteScanline_)
-    {
-        pixel.initialized = false;
-    }
-}
+    // Find the top two opaque layers at each dot. Layers are merged one at a time into the running top two, using selects instead
+    // of branches so that the compiler can vectorize each pass.
+    std::array<u8, LCD_WIDTH> topKeys;
+    std::array<u8, LCD_WIDTH> bottomKeys;
+    topKeys.fill(TRANSPARENT_KEY);
+    bottomKeys.fill(TRANSPARENT_KEY);
+    topColors_.fill(backdrop);
 
-void FrameBuffer::RenderScanline(u16 backdrop, bool forceBlank, BLDCNT bldcnt, BLDALPHA bldalpha, BLDY bldy)
-{
-    if (forceBlank)
+    for (u8 layer = 0; layer < LAYER_COUNT; ++layer)
     {
-        for (auto& pixels : scanline_)
+        if ((activeLayers_ & (1 << layer)) == 0)
         {
-            pixels.clear();
-            frameBuffers_[activeBufferIndex_].at(pixelIndex_++) = 0x7FFF;
+            continue;
         }
 
-        return;
-    }
+        auto const& layerColors = layerColors_[layer];
+        auto const& layerKeys = layerKeys_[layer];
 
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wnarrowing"
-    std::array<bool, 6> firstTargetLayer = {bldcnt.objA, bldcnt.bg0A, bldcnt.bg1A, bldcnt.bg2A, bldcnt.bg3A, bldcnt.bdA};
-    std::array<bool, 6> secondTargetLayer = {bldcnt.objB, bldcnt.bg0B, bldcnt.bg1B, bldcnt.bg2B, bldcnt.bg3B, bldcnt.bdB};
-    #pragma GCC diagnostic pop
+        for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
+        {
+            u8 key = layerKeys[dot];
+            u16 color = layerColors[dot];
+            bool aboveTop = key < topKeys[dot];
+            bool aboveBottom = key < bottomKeys[dot];
+
+            bottomKeys[dot] = aboveTop ? topKeys[dot] : (aboveBottom ? key : bottomKeys[dot]);
+            bottomColors_[dot] = aboveTop ? topColors_[dot] : (aboveBottom ? color : bottomColors_[dot]);
+            topKeys[dot] = aboveTop ? key : topKeys[dot];
+            topColors_[dot] = aboveTop ? color : topColors_[dot];
+        }
+    }
 
-    Pixel bdPixel = Pixel(PixelSrc::BD, backdrop, 4, false);
-    Pixel* pixelA = nullptr;
-    Pixel* pixelB = nullptr;
+    activeLayers_ = 0;
 
-    SpecialEffect bldcntEffect = static_cast<SpecialEffect>(bldcnt.specialEffect);
+    // Bit N of each mask is set if the layer with PixelSrc value N is a target
+    u8 firstTargets =
+        bldcnt.objA | (bldcnt.bg0A << 1) | (bldcnt.bg1A << 2) | (bldcnt.bg2A << 3) | (bldcnt.bg3A << 4) | (bldcnt.bdA << 5);
+    u8 secondTargets =
+        bldcnt.objB | (bldcnt.bg0B << 1) | (bldcnt.bg1B << 2) | (bldcnt.bg2B << 3) | (bldcnt.bg3B << 4) | (bldcnt.bdB << 5);
+    auto bldcntEffect = static_cast<SpecialEffect>(bldcnt.specialEffect);
 
     // Coefficients are 1.4 fixed point values
-    u16 eva = std::min(bldalpha.evaCoefficient, static_cast<u16>(0x10));
-    u16 evb = std::min(bldalpha.evbCoefficient, static_cast<u16>(0x10));
-    u16 evy = std::min(bldy.evyCoefficient, static_cast<u16>(0x10));
+    BlendCoefficients coefficients = {
+        std::min(bldalpha.evaCoefficient, static_cast<u16>(0x10)),
+        std::min(bldalpha.evbCoefficient, static_cast<u16>(0x10)),
+        std::min(bldy.evyCoefficient, static_cast<u16>(0x10))
+    };
 
     for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
     {
-        auto& pixels = scanline_[dot];
-
-        switch (pixels.size())
-        {
-            case 0:
-                pixelA = nullptr;
-                pixelB = nullptr;
-                break;
-            case 1:
-                pixelA = &pixels[0];
-                pixelB = nullptr;
-                break;
-            default:
-                std::nth_element(pixels.begin(), pixels.begin() + 1, pixels.end());
-                pixelA = &pixels[0];
-                pixelB = &pixels[1];
-                break;
-        }
+        // Dots where every layer is transparent show the backdrop, which is never blended with anything underneath it
+        bool hasTop = topKeys[dot] != TRANSPARENT_KEY;
+        bool hasBottom = bottomKeys[dot] != TRANSPARENT_KEY;
+        u8 topLayer = hasTop ? (topKeys[dot] & 0x07) : static_cast<u8>(PixelSrc::BD);
+        u8 bottomLayer = bottomKeys[dot] & 0x07;
 
-        if (!pixelA || pixelA->transparent)
-        {
-            pixelA = &bdPixel;
-            pixelB = nullptr;
-        }
-        else if (pixelB && pixelB->transparent)
-        {
-            pixelB = nullptr;
-        }
+        bool semiTransparent = (topLayer == OBJ_LAYER) && objSemiTransparent_[dot] && hasBottom;
+        bool firstTarget = (firstTargets >> topLayer) & 0x01;
+        bool secondTarget = hasBottom && ((secondTargets >> bottomLayer) & 0x01);
 
-        u16 bgr555 = pixelA->color;
-        SpecialEffect actualEffect = bldcntEffect;
+        SpecialEffect effect = semiTransparent ? SpecialEffect::AlphaBlending :
+                               windowScanline_[dot].effectsEnabled ? bldcntEffect :
+                               SpecialEffect::None;
 
-        if ((pixelA->semiTransparent) && pixelB && !pixelB->transparent)
-        {
-            actualEffect = SpecialEffect::AlphaBlending;
-        }
-        else if (!windowScanline_[dot].effectsEnabled)
-        {
-            actualEffect = SpecialEffect::None;
-        }
+        bool applyEffect = (effect == SpecialEffect::AlphaBlending) ? ((firstTarget || semiTransparent) && secondTarget) :
+                                                                      firstTarget;
 
-        switch (actualEffect)
-        {
-            case SpecialEffect::None:
-                break;
-            case SpecialEffect::AlphaBlending:
-            {
-                if (pixelB && (firstTargetLayer[static_cast<u8>(pixelA->source)] || pixelA->semiTransparent) && secondTargetLayer[static_cast<u8>(pixelB->source)])
-                {
-                    bgr555 = AlphaBlend(eva, evb, pixelA->color, pixelB->color);
-                }
-
-                break;
-            }
-            case SpecialEffect::BrightnessIncrease:
-            {
-                if (firstTargetLayer[static_cast<u8>(pixelA->source)])
-                {
-                    bgr555 = IncreaseBrightness(evy, pixelA->color);
-                }
-
-                break;
-            }
-            case SpecialEffect::BrightnessDecrease:
-            {
-                if (firstTargetLayer[static_cast<u8>(pixelA->source)])
-                {
-                    bgr555 = DecreaseBrightness(evy, pixelA->color);
-                }
+        effects_[dot] = applyEffect ? effect : SpecialEffect::None;
+    }
 
-                break;
-            }
-        }
+    u16* output = &frameBuffers_[activeBufferIndex_].at(pixelIndex_);
+    composite_(topColors_.data(), bottomColors_.data(), effects_.data(), coefficients, output, LCD_WIDTH);
+    FinishScanline();
+}
 
-        frameBuffers_[activeBufferIndex_].at(pixelIndex_++) = bgr555;
-        pixels.clear();
+void FrameBuffer::FinishScanline()
+{
+    if (pixelFormat_ == PixelFormat::XRGB8888)
+    {
+        u16 const* src = &frameBuffers_[activeBufferIndex_].at(pixelIndex_);
+        u32* dest = &(*hostFrameBuffers_)[activeBufferIndex_].at(pixelIndex_);
+        ConvertScanlineToXrgb8888(src, dest);
     }
+
+    pixelIndex_ += LCD_WIDTH;
 }
 
 void FrameBuffer::ResetFrameIndex()
@@ -253,16 +168,46 @@ void FrameBuffer::ResetFrameIndex()
 uchar* FrameBuffer::GetRawFrameBuffer()
 {
     u8 index = (activeBufferIndex_ == 0) ? frameBuffers_.size() - 1 : activeBufferIndex_ - 1;
+
+    if (pixelFormat_ == PixelFormat::XRGB8888)
+    {
+        return reinterpret_cast<uchar*>(hostFrameBuffers_->at(index).data());
+    }
+
     return reinterpret_cast<uchar*>(frameBuffers_.at(index).data());
 }
 
+void FrameBuffer::SetPixelFormat(PixelFormat format)
+{
+    // Host buffers aren't updated while in BGR555 mode, so convert everything rendered so far each time XRGB8888 is switched to.
+    if ((format == PixelFormat::XRGB8888) && (pixelFormat_ != PixelFormat::XRGB8888))
+    {
+        if (!hostFrameBuffers_)
+        {
+            hostFrameBuffers_ = std::make_unique<std::array<HostPixelBuffer, 3>>();
+        }
+
+        for (u8 i = 0; i < frameBuffers_.size(); ++i)
+        {
+            for (size_t pixelIndex = 0; pixelIndex < frameBuffers_[i].size(); pixelIndex += LCD_WIDTH)
+            {
+                ConvertScanlineToXrgb8888(&frameBuffers_[i][pixelIndex], &(*hostFrameBuffers_)[i][pixelIndex]);
+            }
+        }
+    }
+
+    pixelFormat_ = format;
+}
+
 void FrameBuffer::Reset()
 {
-    for (auto& pixelBuffer : scanline_)
+    for (auto& keys : layerKeys_)
     {
-        pixelBuffer.clear();
+        keys.fill(TRANSPARENT_KEY);
     }
 
+    activeLayers_ = 0;
+
     WindowSettings allEnabled = {
         {true, true, true, true},
         true,
@@ -270,7 +215,6 @@ void FrameBuffer::Reset()
     };
 
     InitializeWindow(allEnabled);
-    ClearSpritePixels();
 
     activeBufferIndex_ = (activeBufferIndex_ + 1) % frameBuffers_.size();
     pixelIndex_ = 0;
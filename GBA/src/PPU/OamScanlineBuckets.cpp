@@ -0,0 +1,180 @@
+#include <GBA/include/PPU/OamScanlineBuckets.hpp>
+#include <algorithm>
+#include <bit>
+#include <GBA/include/PPU/FrameBuffer.hpp>
+#include <GBA/include/PPU/VramViews.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+OamScanlineBuckets::OamScanlineBuckets()
+{
+    for (auto& sprites : scanlines_)
+    {
+        sprites = {0, 0};
+    }
+
+    for (auto& bounds : bounds_)
+    {
+        bounds = {0, 0, 0, 0, 0, 0};
+    }
+
+    objWindowSprites_ = {0, 0};
+    InvalidateAll();
+}
+
+void OamScanlineBuckets::InvalidateAll()
+{
+    dirty_ = {U64_MAX, U64_MAX};
+}
+
+void OamScanlineBuckets::Update(Oam oam)
+{
+    for (u8 word = 0; word < dirty_.size(); ++word)
+    {
+        while (dirty_[word] != 0)
+        {
+            u8 index = (word * 64) + std::countr_zero(dirty_[word]);
+            u64 bit = 1ULL << (index % 64);
+            dirty_[word] &= ~bit;
+            SpriteBounds& bounds = bounds_[index];
+
+            for (u8 line = bounds.firstLine; line < (bounds.firstLine + bounds.lineCount); ++line)
+            {
+                scanlines_[line][word] &= ~bit;
+            }
+
+            OamEntry const& entry = oam[index];
+            DecodeBounds(entry, bounds);
+
+            for (u8 line = bounds.firstLine; line < (bounds.firstLine + bounds.lineCount); ++line)
+            {
+                scanlines_[line][word] |= bit;
+            }
+
+            if (entry.attribute0.gfxMode == 2)
+            {
+                objWindowSprites_[word] |= bit;
+            }
+            else
+            {
+                objWindowSprites_[word] &= ~bit;
+            }
+        }
+    }
+}
+
+void OamScanlineBuckets::DecodeBounds(OamEntry const& entry, SpriteBounds& bounds)
+{
+    bounds.lineCount = 0;
+
+    if ((entry.attribute0.objMode == 2) ||  // Disabled sprite
+        (entry.attribute0.gfxMode == 3))    // Illegal gfx mode
+    {
+        return;
+    }
+
+    u8 height;
+    u8 width;
+    u8 dimensions = (entry.attribute0.shape << 2) | entry.attribute1.size;
+
+    switch (dimensions)
+    {
+        // Square
+        case 0b0000:
+            height = 8;
+            width = 8;
+            break;
+        case 0b0001:
+            height = 16;
+            width = 16;
+            break;
+        case 0b0010:
+            height = 32;
+            width = 32;
+            break;
+        case 0b0011:
+            height = 64;
+            width = 64;
+            break;
+
+        // Horizontal
+        case 0b0100:
+            height = 8;
+            width = 16;
+            break;
+        case 0b0101:
+            height = 8;
+            width = 32;
+            break;
+        case 0b0110:
+            height = 16;
+            width = 32;
+            break;
+        case 0b0111:
+            height = 32;
+            width = 64;
+            break;
+
+        // Vertical
+        case 0b1000:
+            height = 16;
+            width = 8;
+            break;
+        case 0b1001:
+            height = 32;
+            width = 8;
+            break;
+        case 0b1010:
+            height = 32;
+            width = 16;
+            break;
+        case 0b1011:
+            height = 64;
+            width = 32;
+            break;
+
+        // Illegal combinations
+        default:
+            return;
+    }
+
+    i16 y = entry.attribute0.y;
+    i16 x = entry.attribute1.x;
+
+    if (y >= LCD_HEIGHT)
+    {
+        y -= 256;
+    }
+
+    if (x & 0x0100)
+    {
+        x = (~0x01FF) | (x & 0x01FF);
+    }
+
+    i16 topEdge = y;
+    i16 bottomEdge = y + height - 1;
+
+    if (entry.attribute0.objMode == 3)
+    {
+        y += (height / 2);
+        x += (width / 2);
+        topEdge = y - (height / 2);
+        bottomEdge = topEdge + (2 * height) - 1;
+    }
+
+    bounds.x = x;
+    bounds.y = y;
+    bounds.width = width;
+    bounds.height = height;
+
+    topEdge = std::max(topEdge, static_cast<i16>(0));
+    bottomEdge = std::min(bottomEdge, static_cast<i16>(LCD_HEIGHT - 1));
+
+    if (topEdge <= bottomEdge)
+    {
+        bounds.firstLine = topEdge;
+        bounds.lineCount = bottomEdge - topEdge + 1;
+    }
+}
+}  // namespace graphics
@@ -1,12 +1,15 @@
 #include <GBA/include/PPU/PPU.hpp>
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
 #include <cstring>
 #include <fstream>
+#include <memory>
 #include <span>
 #include <GBA/include/Memory/MemoryMap.hpp>
 #include <GBA/include/PPU/Registers.hpp>
+#include <GBA/include/PPU/RenderThread.hpp>
 #include <GBA/include/PPU/VramViews.hpp>
 #include <GBA/include/System/EventScheduler.hpp>
 #include <GBA/include/System/SystemControl.hpp>
@@ -15,7 +18,17 @@
 
 namespace graphics
 {
-PPU::PPU(EventScheduler& scheduler, SystemControl& systemControl) : scheduler_(scheduler), systemControl_(systemControl)
+PPU::PPU(EventScheduler& scheduler, SystemControl& systemControl) : PPU(scheduler, systemControl, nullptr)
+{
+    scheduler_.RegisterEvent(EventType::VDraw, {&PPU::VDraw, *this});
+    scheduler_.ScheduleEvent(EventType::HBlank, 960 + 46);
+}
+
+PPU::PPU(EventScheduler& scheduler, SystemControl& systemControl, FrameBuffer* sharedFrameBuffer) :
+    ownedFrameBuffer_((sharedFrameBuffer == nullptr) ? std::make_unique<FrameBuffer>() : nullptr),
+    frameBuffer_((sharedFrameBuffer == nullptr) ? *ownedFrameBuffer_ : *sharedFrameBuffer),
+    scheduler_(scheduler),
+    systemControl_(systemControl)
 {
     window0EnabledOnScanline_ = false;
     window1EnabledOnScanline_ = false;
@@ -27,77 +40,159 @@ PPU::PPU(EventScheduler& scheduler, SystemControl& systemControl) : scheduler_(s
 
     fpsCounter_ = 0;
 
+    frameSkipMode_ = FrameSkipMode::Off;
+    framesToSkip_ = 0;
+    framesSkipped_ = 0;
+    renderingFrame_ = true;
+
     PRAM_.fill(std::byte{0});
     OAM_.fill(std::byte{0});
     VRAM_.fill(std::byte{0});
     registers_.fill(std::byte{0});
+}
 
-    scheduler_.RegisterEvent(EventType::VDraw, [this](int extraCycles){ this->VDraw(extraCycles); });
-    scheduler_.ScheduleEvent(EventType::HBlank, 960 + 46);
+PPU::~PPU() = default;
+
+uchar* PPU::GetRawFrameBuffer()
+{
+    if (renderThread_)
+    {
+        renderThread_->WaitForQueuedFrames();
+    }
+
+    return frameBuffer_.GetRawFrameBuffer();
+}
+
+void PPU::SetPixelFormat(PixelFormat format)
+{
+    if (renderThread_)
+    {
+        renderThread_->Synchronize();
+    }
+
+    frameBuffer_.SetPixelFormat(format);
+}
+
+void PPU::SetAsyncRendering(bool enabled)
+{
+    if (enabled && !renderThread_)
+    {
+        renderThread_ = std::make_unique<RenderThread>(*this);
+    }
+    else if (!enabled && renderThread_)
+    {
+        renderThread_.reset();
+    }
+}
+
+TileCacheStats PPU::GetTileCacheStats() const
+{
+    TileCacheStats stats = tileCache_.GetStats();
+
+    if (renderThread_)
+    {
+        renderThread_->Synchronize();
+        TileCacheStats renderThreadStats = renderThread_->GetTileCacheStats();
+        stats.hits += renderThreadStats.hits;
+        stats.misses += renderThreadStats.misses;
+    }
+
+    return stats;
+}
+
+void PPU::SetFrameSkip(FrameSkipMode mode, u8 framesToSkip)
+{
+    if (mode != frameSkipMode_)
+    {
+        framesSkipped_ = 0;
+    }
+
+    frameSkipMode_ = mode;
+    framesToSkip_ = framesToSkip;
 }
 
 ///---------------------------------------------------------------------------------------------------------------------------------
 /// Bus functionality
 ///---------------------------------------------------------------------------------------------------------------------------------
 
-MemReadData PPU::ReadPRAM(u32 addr, AccessSize length)
+template <AccessSize Length>
+MemReadData PPU::ReadPRAM(u32 addr)
 {
     if (addr > PRAM_ADDR_MAX)
     {
         addr = StandardMirroredAddress(addr, PRAM_ADDR_MIN, PRAM_ADDR_MAX);
     }
 
-    u32 val = ReadMemoryBlock(PRAM_, addr, PRAM_ADDR_MIN, length);
-    int cycles = (length == AccessSize::WORD) ? 2 : 1;
+    u32 val = ReadMemoryBlockUnchecked(PRAM_, addr, PRAM_ADDR_MIN, Length);
+    int cycles = (Length == AccessSize::WORD) ? 2 : 1;
     return {cycles, val, false};
 }
 
-int PPU::WritePRAM(u32 addr, u32 val, AccessSize length)
+template <AccessSize Length>
+int PPU::WritePRAM(u32 addr, u32 val)
 {
-    if (length == AccessSize::BYTE)
+    if constexpr (Length == AccessSize::BYTE)
     {
-        length = AccessSize::HALFWORD;
-        addr &= ~0x01;
-        val = (val & U8_MAX) * 0x0101;
+        return WritePRAM<AccessSize::HALFWORD>(addr & ~0x01, (val & U8_MAX) * 0x0101);
     }
-
-    if (addr > PRAM_ADDR_MAX)
+    else
     {
-        addr = StandardMirroredAddress(addr, PRAM_ADDR_MIN, PRAM_ADDR_MAX);
-    }
+        if (addr > PRAM_ADDR_MAX)
+        {
+            addr = StandardMirroredAddress(addr, PRAM_ADDR_MIN, PRAM_ADDR_MAX);
+        }
 
-    WriteMemoryBlock(PRAM_, addr, PRAM_ADDR_MIN, val, length);
-    return (length == AccessSize::WORD) ? 2 : 1;
+        WriteMemoryBlockUnchecked(PRAM_, addr, PRAM_ADDR_MIN, val, Length);
+
+        if (renderThread_)
+        {
+            renderThread_->QueueMemoryWrite(addr);
+        }
+
+        return (Length == AccessSize::WORD) ? 2 : 1;
+    }
 }
 
-MemReadData PPU::ReadOAM(u32 addr, AccessSize length)
+template <AccessSize Length>
+MemReadData PPU::ReadOAM(u32 addr)
 {
     if (addr > OAM_ADDR_MAX)
     {
         addr = StandardMirroredAddress(addr, OAM_ADDR_MIN, OAM_ADDR_MAX);
     }
 
-    u32 val = ReadMemoryBlock(OAM_, addr, OAM_ADDR_MIN, length);
+    u32 val = ReadMemoryBlockUnchecked(OAM_, addr, OAM_ADDR_MIN, Length);
     return {1, val, false};
 }
 
-int PPU::WriteOAM(u32 addr, u32 val, AccessSize length)
+template <AccessSize Length>
+int PPU::WriteOAM(u32 addr, u32 val)
 {
-    if (length == AccessSize::BYTE)
+    if constexpr (Length == AccessSize::BYTE)
     {
         return 1;
     }
-
-    if (addr > OAM_ADDR_MAX)
+    else
     {
-        addr = StandardMirroredAddress(addr, OAM_ADDR_MIN, OAM_ADDR_MAX);
-    }
+        if (addr > OAM_ADDR_MAX)
+        {
+            addr = StandardMirroredAddress(addr, OAM_ADDR_MIN, OAM_ADDR_MAX);
+        }
 
-    WriteMemoryBlock(OAM_, addr, OAM_ADDR_MIN, val, length);
-    return 1;
+        WriteMemoryBlockUnchecked(OAM_, addr, OAM_ADDR_MIN, val, Length);
+        oamBuckets_.Invalidate(addr - OAM_ADDR_MIN);
+
+        if (renderThread_)
+        {
+            renderThread_->QueueMemoryWrite(addr);
+        }
+
+        return 1;
+    }
 }
 
-MemReadData PPU::ReadVRAM(u32 addr, AccessSize length)
+template <AccessSize Length>
+MemReadData PPU::ReadVRAM(u32 addr)
 {
     if (addr > VRAM_ADDR_MAX)
     {
@@ -109,12 +204,13 @@ MemReadData PPU::ReadVRAM(u32 addr, AccessSize length)
         }
     }
 
-    u32 val = ReadMemoryBlock(VRAM_, addr, VRAM_ADDR_MIN, length);
-    int cycles = (length == AccessSize::WORD) ? 2 : 1;
+    u32 val = ReadMemoryBlockUnchecked(VRAM_, addr, VRAM_ADDR_MIN, Length);
+    int cycles = (Length == AccessSize::WORD) ? 2 : 1;
     return {cycles, val, false};
 }
 
-int PPU::WriteVRAM(u32 addr, u32 val, AccessSize length)
+template <AccessSize Length>
+int PPU::WriteVRAM(u32 addr, u32 val)
 {
     if (addr > VRAM_ADDR_MAX)
     {
@@ -126,7 +222,7 @@ int PPU::WriteVRAM(u32 addr, u32 val, AccessSize length)
         }
     }
 
-    if (length == AccessSize::BYTE)
+    if constexpr (Length == AccessSize::BYTE)
     {
         DISPCNT dispcnt = GetDISPCNT();
 
@@ -136,15 +232,41 @@ int PPU::WriteVRAM(u32 addr, u32 val, AccessSize length)
             return 1;
         }
 
-        length = AccessSize::HALFWORD;
-        addr &= ~0x01;
-        val = (val & U8_MAX) * 0x0101;
+        return WriteVRAM<AccessSize::HALFWORD>(addr & ~0x01, (val & U8_MAX) * 0x0101);
     }
+    else
+    {
+        WriteMemoryBlockUnchecked(VRAM_, addr, VRAM_ADDR_MIN, val, Length);
+        tileCache_.Invalidate(addr - VRAM_ADDR_MIN);
+
+        if (renderThread_)
+        {
+            renderThread_->QueueMemoryWrite(addr);
+        }
 
-    WriteMemoryBlock(VRAM_, addr, VRAM_ADDR_MIN, val, length);
-    return (length == AccessSize::WORD) ? 2 : 1;
+        return (Length == AccessSize::WORD) ? 2 : 1;
+    }
 }
 
+template MemReadData PPU::ReadPRAM<AccessSize::BYTE>(u32);
+template MemReadData PPU::ReadPRAM<AccessSize::HALFWORD>(u32);
+template MemReadData PPU::ReadPRAM<AccessSize::WORD>(u32);
+template int PPU::WritePRAM<AccessSize::BYTE>(u32, u32);
+template int PPU::WritePRAM<AccessSize::HALFWORD>(u32, u32);
+template int PPU::WritePRAM<AccessSize::WORD>(u32, u32);
+template MemReadData PPU::ReadOAM<AccessSize::BYTE>(u32);
+template MemReadData PPU::ReadOAM<AccessSize::HALFWORD>(u32);
+template MemReadData PPU::ReadOAM<AccessSize::WORD>(u32);
+template int PPU::WriteOAM<AccessSize::BYTE>(u32, u32);
+template int PPU::WriteOAM<AccessSize::HALFWORD>(u32, u32);
+template int PPU::WriteOAM<AccessSize::WORD>(u32, u32);
+template MemReadData PPU::ReadVRAM<AccessSize::BYTE>(u32);
+template MemReadData PPU::ReadVRAM<AccessSize::HALFWORD>(u32);
+template MemReadData PPU::ReadVRAM<AccessSize::WORD>(u32);
+template int PPU::WriteVRAM<AccessSize::BYTE>(u32, u32);
+template int PPU::WriteVRAM<AccessSize::HALFWORD>(u32, u32);
+template int PPU::WriteVRAM<AccessSize::WORD>(u32, u32);
+
 MemReadData PPU::ReadReg(u32 addr, AccessSize length)
 {
     if (((0x0400'0010 <= addr) && (addr < 0x0400'0048)) ||
@@ -159,6 +281,12 @@ MemReadData PPU::ReadReg(u32 addr, AccessSize length)
     return {1, val, false};
 }
 
+MemReadData PPU::ReadDispstatVcount(u32 addr, AccessSize length)
+{
+    u32 val = ReadMemoryBlockUnchecked(registers_, addr, LCD_IO_ADDR_MIN, length);
+    return {1, val, false};
+}
+
 int PPU::WriteReg(u32 addr, u32 val, AccessSize length)
 {
     if ((0x0400'0004 <= addr) && (addr < 0x0400'0008))
@@ -209,6 +337,11 @@ void PPU::Serialize(std::ofstream& saveState) const
 
 void PPU::Deserialize(std::ifstream& saveState)
 {
+    if (renderThread_)
+    {
+        renderThread_->Synchronize();
+    }
+
     DeserializeTrivialType(window0EnabledOnScanline_);
     DeserializeTrivialType(window1EnabledOnScanline_);
     DeserializeTrivialType(bg2RefX_);
@@ -219,7 +352,14 @@ void PPU::Deserialize(std::ifstream& saveState)
     DeserializeArray(OAM_);
     DeserializeArray(VRAM_);
     DeserializeArray(registers_);
+    oamBuckets_.InvalidateAll();
+    tileCache_.InvalidateAll();
     frameBuffer_.Reset();
+
+    if (renderThread_)
+    {
+        renderThread_->ReloadMemory();
+    }
 }
 
 ///---------------------------------------------------------------------------------------------------------------------------------
@@ -348,7 +488,19 @@ void PPU::HBlank(int extraCycles)
     // Render the current scanline
     if (scanline < 160)
     {
-        EvaluateScanline();
+        if (renderingFrame_)
+        {
+            if (renderThread_)
+            {
+                renderThread_->QueueScanline();
+            }
+            else
+            {
+                EvaluateScanline();
+            }
+        }
+
+        IncrementAffineBackgroundReferencePoints();
     }
 }
 
@@ -363,9 +515,22 @@ void PPU::VBlank(int extraCycles)
     if (scanline == 160)
     {
         dispstat.vBlank = 1;
-        frameBuffer_.ResetFrameIndex();
         ++fpsCounter_;
 
+        if (renderingFrame_)
+        {
+            if (renderThread_)
+            {
+                renderThread_->QueueEndOfFrame();
+            }
+            else
+            {
+                frameBuffer_.ResetFrameIndex();
+            }
+        }
+
+        renderingFrame_ = RenderNextFrame();
+
         if (dispstat.vBlankIrqEnable)
         {
             systemControl_.RequestInterrupt(InterruptType::LCD_VBLANK);
@@ -579,9 +744,8 @@ void PPU::EvaluateScanline()
 
         if (dispcnt.screenDisplayObj)
         {
-            frameBuffer_.ClearSpritePixels();
+            frameBuffer_.BeginSpriteLayer();
             EvaluateOAM();
-            frameBuffer_.PushSpritePixels();
         }
 
         switch (dispcnt.bgMode)
@@ -611,7 +775,30 @@ void PPU::EvaluateScanline()
     auto bldy = MemCpyInit<BLDY>(&registers_[BLDY::INDEX]);
 
     frameBuffer_.RenderScanline(backdropColor, dispcnt.forceBlank, bldcnt, bldalpha, bldy);
-    IncrementAffineBackgroundReferencePoints();
+}
+
+bool PPU::RenderNextFrame()
+{
+    switch (frameSkipMode_)
+    {
+        case FrameSkipMode::Off:
+            return true;
+        case FrameSkipMode::NeverRender:
+            return false;
+        case FrameSkipMode::Fixed:
+        case FrameSkipMode::Auto:
+        default:
+            break;
+    }
+
+    if (framesSkipped_ >= framesToSkip_)
+    {
+        framesSkipped_ = 0;
+        return true;
+    }
+
+    ++framesSkipped_;
+    return false;
 }
 
 void PPU::RenderMode0Scanline()
@@ -705,11 +892,13 @@ void PPU::RenderMode3Scanline()
     }
 
     size_t bitmapIndex = scanline * LCD_WIDTH * sizeof(u16);
+    FrameBuffer& frameBuffer = frameBuffer_;
+    frameBuffer.BeginBackgroundLayer(2);
 
     for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
     {
         u16 color = MemCpyInit<u16>(&VRAM_[bitmapIndex]);
-        frameBuffer_.PushPixel({PixelSrc::BG2, color, priority, false}, dot);
+        frameBuffer.SetBackgroundPixel(2, dot, color, priority, false);
         bitmapIndex += sizeof(u16);
     }
 }
@@ -733,12 +922,16 @@ void PPU::RenderMode4Scanline()
         bitmapIndex += 0xA000;
     }
 
+    FrameBuffer& frameBuffer = frameBuffer_;
+
+    frameBuffer.BeginBackgroundLayer(2);
+
     for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
     {
         u8 paletteIndex = static_cast<u8>(VRAM_[bitmapIndex++]);
         u16 color = GetBgColor(paletteIndex);
         bool transparent = (paletteIndex == 0);
-        frameBuffer_.PushPixel({PixelSrc::BG2, color, priority, transparent}, dot);
+        frameBuffer.SetBackgroundPixel(2, dot, color, priority, transparent);
     }
 }
 
@@ -762,64 +955,54 @@ void PPU::RenderRegularTiledBackgroundScanline(BGCNT bgcnt, u8 bgIndex, u16 xOff
 
 void PPU::RenderRegular4bppBackground(BGCNT bgcnt, u8 bgIndex, u16 x, u16 y, u16 width)
 {
-    BackgroundCharBlockView charBlock(VRAM_, bgcnt.charBaseBlock);
     RegularScreenBlockScanlineView screenBlock(*this, bgcnt.screenBaseBlock, x, y, width);
-    CharBlockEntry4 charBlockEntry;
-    charBlock.GetCharBlock(charBlockEntry, screenBlock.TileIndex());
+    DecodedTile const* tile = &tileCache_.Get4bppTile(VRAM_, bgcnt.charBaseBlock, screenBlock.TileIndex());
 
-    auto src = static_cast<PixelSrc>(bgIndex + 1);
     u8 priority = bgcnt.priority;
+    FrameBuffer& frameBuffer = frameBuffer_;
+    frameBuffer.BeginBackgroundLayer(bgIndex);
 
     for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
     {
-        if (frameBuffer_.GetWindowSettings(dot).bgEnabled[bgIndex])
+        if (frameBuffer.GetWindowSettings(dot).bgEnabled[bgIndex])
         {
-            u8 tileX = screenBlock.TileX();
-            u8 tileY = screenBlock.TileY();
-            bool left = (tileX % 2) == 0;
-
-            auto colors = charBlockEntry.pixels[tileY][tileX / 2];
-            u8 colorIndex = left ? colors.leftColorIndex : colors.rightColorIndex;
+            u8 colorIndex = (*tile)[screenBlock.TileY()][screenBlock.TileX()];
             bool transparent = colorIndex == 0;
             u16 bgr555 = transparent ? GetBgColor(0) : GetBgColor(screenBlock.Palette(), colorIndex);
 
-            frameBuffer_.PushPixel({src, bgr555, priority, transparent}, dot);
+            frameBuffer.SetBackgroundPixel(bgIndex, dot, bgr555, priority, transparent);
         }
 
         if (screenBlock.Update())
         {
-            charBlock.GetCharBlock(charBlockEntry, screenBlock.TileIndex());
+            tile = &tileCache_.Get4bppTile(VRAM_, bgcnt.charBaseBlock, screenBlock.TileIndex());
         }
     }
 }
 
 void PPU::RenderRegular8bppBackground(BGCNT bgcnt, u8 bgIndex, u16 x, u16 y, u16 width)
 {
-    BackgroundCharBlockView charBlock(VRAM_, bgcnt.charBaseBlock);
     RegularScreenBlockScanlineView screenBlock(*this, bgcnt.screenBaseBlock, x, y, width);
-    CharBlockEntry8 charBlockEntry;
-    charBlock.GetCharBlock(charBlockEntry, screenBlock.TileIndex());
+    DecodedTile const* tile = &tileCache_.Get8bppTile(VRAM_, bgcnt.charBaseBlock, screenBlock.TileIndex());
 
-    auto src = static_cast<PixelSrc>(bgIndex + 1);
     u8 priority = bgcnt.priority;
+    FrameBuffer& frameBuffer = frameBuffer_;
+    frameBuffer.BeginBackgroundLayer(bgIndex);
 
     for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
     {
-        if (frameBuffer_.GetWindowSettings(dot).bgEnabled[bgIndex])
+        if (frameBuffer.GetWindowSettings(dot).bgEnabled[bgIndex])
         {
-            u8 tileX = screenBlock.TileX();
-            u8 tileY = screenBlock.TileY();
-
-            u8 paletteIndex = charBlockEntry.pixels[tileY][tileX];
+            u8 paletteIndex = (*tile)[screenBlock.TileY()][screenBlock.TileX()];
             bool transparent = paletteIndex == 0;
             u16 bgr555 = GetBgColor(paletteIndex);
 
-            frameBuffer_.PushPixel({src, bgr555, priority, transparent}, dot);
+            frameBuffer.SetBackgroundPixel(bgIndex, dot, bgr555, priority, transparent);
         }
 
         if (screenBlock.Update())
         {
-            charBlock.GetCharBlock(charBlockEntry, screenBlock.TileIndex());
+            tile = &tileCache_.Get8bppTile(VRAM_, bgcnt.charBaseBlock, screenBlock.TileIndex());
         }
     }
 }
@@ -847,9 +1030,10 @@ void PPU::RenderAffineTiledBackgroundScanline(BGCNT bgcnt, u8 bgIndex, i32 x, i3
 
     u16 mapWidthPixels = mapWidthTiles * 8;
 
-    auto src = static_cast<PixelSrc>(bgIndex + 1);
     u8 priority = bgcnt.priority;
     bool wrap = bgcnt.wrapAround;
+    FrameBuffer& frameBuffer = frameBuffer_;
+    frameBuffer.BeginBackgroundLayer(bgIndex);
 
     size_t baseAddr = bgcnt.screenBaseBlock * SCREEN_BLOCK_SIZE;
     size_t screenBlockSize = mapWidthTiles * mapWidthTiles;
@@ -859,7 +1043,7 @@ void PPU::RenderAffineTiledBackgroundScanline(BGCNT bgcnt, u8 bgIndex, i32 x, i3
 
     for (u8 dot = 0; dot < LCD_WIDTH; ++dot)
     {
-        if (frameBuffer_.GetWindowSettings(dot).bgEnabled[bgIndex])
+        if (frameBuffer.GetWindowSettings(dot).bgEnabled[bgIndex])
         {
             i32 screenX = x >> 8;
             i32 screenY = y >> 8;
@@ -890,7 +1074,7 @@ void PPU::RenderAffineTiledBackgroundScanline(BGCNT bgcnt, u8 bgIndex, i32 x, i3
 
             bool transparent = paletteIndex == 0;
             u16 bgr555 = GetBgColor(paletteIndex);
-            frameBuffer_.PushPixel({src, bgr555, priority, transparent}, dot);
+            frameBuffer.SetBackgroundPixel(bgIndex, dot, bgr555, priority, transparent);
         }
 
         x += dx;
@@ -901,123 +1085,26 @@ void PPU::RenderAffineTiledBackgroundScanline(BGCNT bgcnt, u8 bgIndex, i32 x, i3
 void PPU::EvaluateOAM(WindowSettings* windowSettingsPtr)
 {
     Oam oam(reinterpret_cast<const OamEntry*>(OAM_.data()), 128);
-    bool windowEval = windowSettingsPtr != nullptr;
-    u8 scanline = GetVCOUNT();
-    auto dispcnt = GetDISPCNT();
+    bool oneDim = GetDISPCNT().objCharacterVramMapping;
+    SpriteMask sprites = oamBuckets_.GetSprites(oam, GetVCOUNT(), windowSettingsPtr != nullptr);
 
-    for (u8 i = 0; i < 128; ++i)
+    for (u8 word = 0; word < sprites.size(); ++word)
     {
-        OamEntry const& entry = oam[i];
-
-        if ((windowEval && (entry.attribute0.gfxMode != 2)) ||      // Skip window sprites if not evaluating window
-            (!windowEval && (entry.attribute0.gfxMode == 2)) ||     // Skip visible sprites if evaluating window
-            (entry.attribute0.objMode == 2) ||                      // Skip disabled sprites
-            (entry.attribute0.gfxMode == 3))                        // Skip illegal gfx mode
+        while (sprites[word] != 0)
         {
-            continue;
-        }
-
-        u8 height;
-        u8 width;
-        u8 dimensions = (entry.attribute0.shape << 2) | entry.attribute1.size;
-
-        switch (dimensions)
-        {
-            // Square
-            case 0b0000:
-                height = 8;
-                width = 8;
-                break;
-            case 0b0001:
-                height = 16;
-                width = 16;
-                break;
-            case 0b0010:
-                height = 32;
-                width = 32;
-                break;
-            case 0b0011:
-                height = 64;
-                width = 64;
-                break;
+            u8 i = (word * 64) + std::countr_zero(sprites[word]);
+            sprites[word] &= (sprites[word] - 1);
+            OamEntry const& entry = oam[i];
+            SpriteBounds const& bounds = oamBuckets_.GetBounds(i);
 
-            // Horizontal
-            case 0b0100:
-                height = 8;
-                width = 16;
-                break;
-            case 0b0101:
-                height = 8;
-                width = 32;
-                break;
-            case 0b0110:
-                height = 16;
-                width = 32;
-                break;
-            case 0b0111:
-                height = 32;
-                width = 64;
-                break;
-
-            // Vertical
-            case 0b1000:
-                height = 16;
-                width = 8;
-                break;
-            case 0b1001:
-                height = 32;
-                width = 8;
-                break;
-            case 0b1010:
-                height = 32;
-                width = 16;
-                break;
-            case 0b1011:
-                height = 64;
-                width = 32;
-                break;
-
-            // Illegal combinations
-            default:
-                continue;
-        }
-
-        i16 y = entry.attribute0.y;
-        i16 x = entry.attribute1.x;
-
-        if (y >= 160)
-        {
-            y -= 256;
-        }
-
-        if (x & 0x0100)
-        {
-            x = (~0x01FF) | (x & 0x01FF);
-        }
-
-        i16 topEdge = y;
-        i16 bottomEdge = y + height - 1;
-
-        if (entry.attribute0.objMode == 3)
-        {
-            y += (height / 2);
-            x += (width / 2);
-            topEdge = y - (height / 2);
-            bottomEdge = topEdge + (2 * height) - 1;
-        }
-
-        if ((topEdge > scanline) || (scanline > bottomEdge))
-        {
-            continue;
-        }
-
-        if (entry.attribute0.objMode == 0)
-        {
-            RenderRegSprite(dispcnt.objCharacterVramMapping, x, y, width, height, entry, windowSettingsPtr);
-        }
-        else
-        {
-            RenderAffSprite(dispcnt.objCharacterVramMapping, x, y, width, height, entry, windowSettingsPtr);
+            if (entry.attribute0.objMode == 0)
+            {
+                RenderRegSprite(oneDim, bounds.x, bounds.y, bounds.width, bounds.height, entry, windowSettingsPtr);
+            }
+            else
+            {
+                RenderAffSprite(oneDim, bounds.x, bounds.y, bounds.width, bounds.height, entry, windowSettingsPtr);
+            }
         }
     }
 }
@@ -1148,21 +1235,7 @@ void PPU::PushSpritePixel(u8 dot, u16 color, u8 priority, bool transparent, bool
     if (windowSettingsPtr == nullptr)
     {
         // Visible Sprite
-        Pixel& currentPixel = frameBuffer_.GetSpritePixel(dot);
-        u8 priorityToSet = priority;
-
-        if (currentPixel.initialized && (currentPixel.priority < priority))
-        {
-            priorityToSet = currentPixel.priority;
-        }
-
-        if (frameBuffer_.GetWindowSettings(dot).objEnabled && !transparent &&
-            (!currentPixel.initialized || (priority < currentPixel.priority) || currentPixel.transparent))
-        {
-            currentPixel = Pixel(PixelSrc::OBJ, color, priority, transparent, semiTransparent);
-        }
-
-        currentPixel.priority = priorityToSet;
+        frameBuffer_.SetSpritePixel(dot, color, priority, transparent, semiTransparent);
     }
     else if (!transparent)
     {
@@ -0,0 +1,229 @@
+#include <GBA/include/PPU/RenderThread.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <GBA/include/Memory/MemoryMap.hpp>
+#include <GBA/include/PPU/PPU.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+RenderThread::RenderThread(PPU& ppu) :
+    ppu_(ppu),
+    renderer_(ppu.scheduler_, ppu.systemControl_, &ppu.frameBuffer_)
+{
+    memoryWritesQueued_ = 0;
+    memoryWritesApplied_ = 0;
+    commandsQueued_ = 0;
+
+    wakeCounter_ = 0;
+    commandsCompleted_ = 0;
+    framesQueued_ = 0;
+    framesCompleted_ = 0;
+    stopRequested_ = false;
+
+    ReloadMemory();
+    worker_ = std::thread(&RenderThread::Run, this);
+}
+
+RenderThread::~RenderThread()
+{
+    Synchronize();
+    stopRequested_.store(true, std::memory_order_release);
+    WakeWorker();
+    worker_.join();
+}
+
+void RenderThread::QueueScanline()
+{
+    Command command = {};
+    command.type = CommandType::DrawScanline;
+    command.window0EnabledOnScanline = ppu_.window0EnabledOnScanline_;
+    command.window1EnabledOnScanline = ppu_.window1EnabledOnScanline_;
+    command.bg2RefX = ppu_.bg2RefX_;
+    command.bg2RefY = ppu_.bg2RefY_;
+    command.bg3RefX = ppu_.bg3RefX_;
+    command.bg3RefY = ppu_.bg3RefY_;
+    command.registers = ppu_.registers_;
+    QueueCommand(command);
+}
+
+void RenderThread::QueueEndOfFrame()
+{
+    Command command = {};
+    command.type = CommandType::EndFrame;
+    QueueCommand(command);
+    framesQueued_.fetch_add(1, std::memory_order_release);
+}
+
+void RenderThread::WaitForQueuedFrames()
+{
+    u32 target = framesQueued_.load(std::memory_order_acquire);
+    u32 completed = framesCompleted_.load(std::memory_order_acquire);
+
+    while (static_cast<i32>(completed - target) < 0)
+    {
+        framesCompleted_.wait(completed, std::memory_order_acquire);
+        completed = framesCompleted_.load(std::memory_order_acquire);
+    }
+}
+
+void RenderThread::Synchronize()
+{
+    Command command = {};
+    command.type = CommandType::Synchronize;
+    QueueCommand(command);
+    u32 completed = commandsCompleted_.load(std::memory_order_acquire);
+
+    while (completed != commandsQueued_)
+    {
+        commandsCompleted_.wait(completed, std::memory_order_acquire);
+        completed = commandsCompleted_.load(std::memory_order_acquire);
+    }
+}
+
+void RenderThread::ReloadMemory()
+{
+    renderer_.PRAM_ = ppu_.PRAM_;
+    renderer_.OAM_ = ppu_.OAM_;
+    renderer_.VRAM_ = ppu_.VRAM_;
+    renderer_.oamBuckets_.InvalidateAll();
+    renderer_.tileCache_.InvalidateAll();
+}
+
+void RenderThread::QueueCommand(Command& command)
+{
+    command.memoryWritesBefore = memoryWritesQueued_;
+
+    while (!commands_.Write(&command, 1))
+    {
+        WakeWorker();
+        std::this_thread::yield();
+    }
+
+    ++commandsQueued_;
+    WakeWorker();
+}
+
+void RenderThread::WakeWorker()
+{
+    wakeCounter_.fetch_add(1, std::memory_order_release);
+    wakeCounter_.notify_one();
+}
+
+void RenderThread::Run()
+{
+    while (true)
+    {
+        u32 wakeCount = wakeCounter_.load(std::memory_order_acquire);
+
+        if (!ProcessQueuedWork())
+        {
+            if (stopRequested_.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            wakeCounter_.wait(wakeCount, std::memory_order_acquire);
+        }
+    }
+}
+
+bool RenderThread::ProcessQueuedWork()
+{
+    // Memory writes are counted before commands. Any write seen here was queued after every command that can be seen below, so
+    // if there turn out to be no commands, all of these writes can be applied without getting ahead of a scanline that needs the
+    // memory as it was before them.
+    size_t memoryWritesAvailable = memoryWrites_.GetAvailable();
+    bool processedCommand = false;
+    Command command;
+
+    while (commands_.Read(&command, 1))
+    {
+        RunCommand(command);
+        processedCommand = true;
+    }
+
+    if (processedCommand)
+    {
+        return true;
+    }
+
+    if (memoryWritesAvailable > 0)
+    {
+        ApplyMemoryWrites(memoryWritesAvailable);
+        return true;
+    }
+
+    return false;
+}
+
+void RenderThread::ApplyMemoryWrites(u64 count)
+{
+    std::array<MemoryWrite, 256> writes;
+
+    while (count > 0)
+    {
+        size_t batchSize = std::min<u64>(count, writes.size());
+        memoryWrites_.Read(writes.data(), batchSize);
+
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            auto [addr, val] = writes[i];
+
+            if (addr < VRAM_ADDR_MIN)
+            {
+                std::memcpy(&renderer_.PRAM_[addr - PRAM_ADDR_MIN], &val, sizeof(u32));
+            }
+            else if (addr < OAM_ADDR_MIN)
+            {
+                std::memcpy(&renderer_.VRAM_[addr - VRAM_ADDR_MIN], &val, sizeof(u32));
+                renderer_.tileCache_.Invalidate(addr - VRAM_ADDR_MIN);
+            }
+            else
+            {
+                std::memcpy(&renderer_.OAM_[addr - OAM_ADDR_MIN], &val, sizeof(u32));
+                renderer_.oamBuckets_.Invalidate(addr - OAM_ADDR_MIN);
+            }
+        }
+
+        count -= batchSize;
+        memoryWritesApplied_ += batchSize;
+    }
+}
+
+void RenderThread::RunCommand(Command const& command)
+{
+    ApplyMemoryWrites(command.memoryWritesBefore - memoryWritesApplied_);
+
+    switch (command.type)
+    {
+        case CommandType::DrawScanline:
+            renderer_.window0EnabledOnScanline_ = command.window0EnabledOnScanline;
+            renderer_.window1EnabledOnScanline_ = command.window1EnabledOnScanline;
+            renderer_.bg2RefX_ = command.bg2RefX;
+            renderer_.bg2RefY_ = command.bg2RefY;
+            renderer_.bg3RefX_ = command.bg3RefX;
+            renderer_.bg3RefY_ = command.bg3RefY;
+            renderer_.registers_ = command.registers;
+            renderer_.EvaluateScanline();
+            break;
+        case CommandType::EndFrame:
+            renderer_.frameBuffer_.ResetFrameIndex();
+            framesCompleted_.fetch_add(1, std::memory_order_release);
+            framesCompleted_.notify_all();
+            break;
+        case CommandType::Synchronize:
+            break;
+    }
+
+    commandsCompleted_.fetch_add(1, std::memory_order_release);
+
+    if (command.type == CommandType::Synchronize)
+    {
+        commandsCompleted_.notify_all();
+    }
+}
+}  // namespace graphics
@@ -0,0 +1,51 @@
+#include <GBA/include/PPU/TileCache.hpp>
+#include <bit>
+#include <cstring>
+#include <GBA/include/PPU/VramViews.hpp>
+#include <GBA/include/Utilities/Types.hpp>
+
+namespace graphics
+{
+TileCache::TileCache()
+{
+    for (auto& row : transparentTile_)
+    {
+        row.fill(0);
+    }
+
+    stats_ = {0, 0};
+    InvalidateAll();
+}
+
+void TileCache::InvalidateAll()
+{
+    valid4_.fill(false);
+    valid8_.fill(false);
+}
+
+void TileCache::Decode4bppTile(VramSpan vram, u32 tileIndex)
+{
+    u32 addr = tileIndex * sizeof(CharBlockEntry4);
+    DecodedTile& tile = tiles4_[tileIndex];
+
+    for (auto& row : tile)
+    {
+        for (u8 x = 0; x < 8; x += 2)
+        {
+            ColorIndexes4 indexes = std::bit_cast<ColorIndexes4>(vram[addr++]);
+            row[x] = indexes.leftColorIndex;
+            row[x + 1] = indexes.rightColorIndex;
+        }
+    }
+
+    valid4_[tileIndex] = true;
+    ++stats_.misses;
+}
+
+void TileCache::Decode8bppTile(VramSpan vram, u32 tileIndex)
+{
+    std::memcpy(&tiles8_[tileIndex], &vram[tileIndex * sizeof(CharBlockEntry8)], sizeof(DecodedTile));
+    valid8_[tileIndex] = true;
+    ++stats_.misses;
+}
+}  // namespace graphics
@@ -1,15 +1,14 @@
 #include <GBA/include/System/EventScheduler.hpp>
-#include <algorithm>
-#include <functional>
+#include <array>
+#include <cstddef>
 #include <fstream>
 #include <optional>
+#include <span>
 #include <stdexcept>
-#include <unordered_map>
-#include <vector>
 #include <GBA/include/Utilities/CommonUtils.hpp>
 #include <GBA/include/Utilities/Types.hpp>
 
-bool Event::operator>(Event const& rhs)
+bool Event::operator>(Event const& rhs) const
 {
     if (cycleToExecute_ == rhs.cycleToExecute_)
     {
@@ -21,18 +20,22 @@ bool Event::operator>(Event const& rhs)
 
 EventScheduler::EventScheduler()
 {
-    queue_.reserve(static_cast<size_t>(EventType::COUNT) + 1);
+    heapIndex_.fill(NOT_SCHEDULED);
+    heapSize_ = 0;
     totalCycles_ = 0;
+    nextEventCycle_ = U64_MAX;
 }
 
 void EventScheduler::RegisterEvent(EventType event, Callback callback)
 {
-    if (callbacks_.contains(event))
+    auto& registeredCallback = callbacks_[static_cast<size_t>(event)];
+
+    if (registeredCallback.Bound())
     {
         throw std::logic_error("Duplicate event registration");
     }
 
-    callbacks_.insert({event, callback});
+    registeredCallback = callback;
 }
 
 void EventScheduler::ScheduleEvent(EventType event, int cycles)
@@ -43,71 +46,54 @@ void EventScheduler::ScheduleEvent(EventType event, int cycles)
     }
 
     u64 cycleToExecute = totalCycles_ + cycles;
-    queue_.push_back({event, totalCycles_, cycleToExecute});
-    MakeMinHeap();
+    Enqueue({event, totalCycles_, cycleToExecute});
 }
 
 void EventScheduler::ScheduleEvent(EventType event, int offset, u32 length)
 {
     u64 cycleQueued = totalCycles_ + offset;
     u64 cycleToExecute = cycleQueued + length;
-    queue_.push_back({event, cycleQueued, cycleToExecute});
-    MakeMinHeap();
-}
-
-void EventScheduler::Step(int cycles)
-{
-    if (cycles <= 0)
-    {
-        throw std::runtime_error("Illegal step count");
-    }
-
-    totalCycles_ += static_cast<u64>(cycles);
-    CheckEventQueue();
+    Enqueue({event, cycleQueued, cycleToExecute});
 }
 
 void EventScheduler::FireNextEvent()
 {
-    totalCycles_ = queue_.front().cycleToExecute_;
+    totalCycles_ = nextEventCycle_;
     CheckEventQueue();
 }
 
 std::optional<int> EventScheduler::UnscheduleEvent(EventType event)
 {
-    std::optional<int> remainingCycles = {};
+    u8 index = heapIndex_[static_cast<size_t>(event)];
 
-    for (auto it = queue_.begin(); it != queue_.end(); ++it)
+    if (index == NOT_SCHEDULED)
     {
-        if (it->eventType_ == event)
-        {
-            remainingCycles = it->cycleToExecute_ - totalCycles_;
-            queue_.erase(it);
-            MakeMinHeap();
-            break;
-        }
+        return {};
     }
 
+    int remainingCycles = heap_[index].cycleToExecute_ - totalCycles_;
+    RemoveAt(index);
     return remainingCycles;
 }
 
 std::optional<int> EventScheduler::ElapsedCycles(EventType event)
 {
-    for (Event const& scheduledEvent : queue_)
+    u8 index = heapIndex_[static_cast<size_t>(event)];
+
+    if (index == NOT_SCHEDULED)
     {
-        if (event == scheduledEvent.eventType_)
-        {
-            return totalCycles_ - scheduledEvent.cycleQueued_;
-        }
+        return {};
     }
 
-    return {};
+    return totalCycles_ - heap_[index].cycleQueued_;
 }
 
 void EventScheduler::Serialize(std::ofstream& saveState) const
 {
-    size_t queueSize = queue_.size();
+    size_t queueSize = heapSize_;
+    auto queue = std::span(heap_.data(), heapSize_);
     SerializeTrivialType(queueSize);
-    SerializeArray(queue_);
+    SerializeArray(queue);
     SerializeTrivialType(totalCycles_);
 }
 
@@ -115,21 +101,126 @@ void EventScheduler::Deserialize(std::ifstream& saveState)
 {
     size_t queueSize;
     DeserializeTrivialType(queueSize);
-    queue_.resize(queueSize);
-    DeserializeArray(queue_);
+
+    if (queueSize > EVENT_COUNT)
+    {
+        throw std::runtime_error("Invalid event queue size in save state");
+    }
+
+    std::array<Event, EVENT_COUNT> queue;
+    auto queueSpan = std::span(queue.data(), queueSize);
+    DeserializeArray(queueSpan);
     DeserializeTrivialType(totalCycles_);
+
+    heapIndex_.fill(NOT_SCHEDULED);
+    heapSize_ = 0;
+    nextEventCycle_ = U64_MAX;
+
+    for (Event const& event : queueSpan)
+    {
+        Enqueue(event);
+    }
 }
 
-void EventScheduler::CheckEventQueue()
+void EventScheduler::Enqueue(Event event)
+{
+    u8 index = heapIndex_[static_cast<size_t>(event.eventType_)];
+
+    if (index == NOT_SCHEDULED)
+    {
+        Place(heapSize_, event);
+        ++heapSize_;
+        SiftUp(heapSize_ - 1);
+    }
+    else
+    {
+        Place(index, event);
+        SiftUp(index);
+        SiftDown(heapIndex_[static_cast<size_t>(event.eventType_)]);
+    }
+
+    UpdateNextEventCycle();
+}
+
+void EventScheduler::RemoveAt(size_t index)
 {
-    Event nextEvent = queue_.front();
+    heapIndex_[static_cast<size_t>(heap_[index].eventType_)] = NOT_SCHEDULED;
+    --heapSize_;
+
+    if (index != heapSize_)
+    {
+        Event lastEvent = heap_[heapSize_];
+        Place(index, lastEvent);
+        SiftUp(index);
+        SiftDown(heapIndex_[static_cast<size_t>(lastEvent.eventType_)]);
+    }
+
+    UpdateNextEventCycle();
+}
 
-    while (totalCycles_ >= nextEvent.cycleToExecute_)
+void EventScheduler::SiftUp(size_t index)
+{
+    Event event = heap_[index];
+
+    while (index > 0)
+    {
+        size_t parentIndex = (index - 1) / 2;
+
+        if (!(heap_[parentIndex] > event))
+        {
+            break;
+        }
+
+        Place(index, heap_[parentIndex]);
+        index = parentIndex;
+    }
+
+    Place(index, event);
+}
+
+void EventScheduler::SiftDown(size_t index)
+{
+    Event event = heap_[index];
+
+    while (true)
+    {
+        size_t childIndex = (2 * index) + 1;
+
+        if (childIndex >= heapSize_)
+        {
+            break;
+        }
+
+        if (((childIndex + 1) < heapSize_) && (heap_[childIndex] > heap_[childIndex + 1]))
+        {
+            ++childIndex;
+        }
+
+        if (!(event > heap_[childIndex]))
+        {
+            break;
+        }
+
+        Place(index, heap_[childIndex]);
+        index = childIndex;
+    }
+
+    Place(index, event);
+}
+
+void EventScheduler::Place(size_t index, Event event)
+{
+    heap_[index] = event;
+    heapIndex_[static_cast<size_t>(event.eventType_)] = static_cast<u8>(index);
+}
+
+void EventScheduler::CheckEventQueue()
+{
+    while (totalCycles_ >= nextEventCycle_)
     {
-        std::pop_heap(queue_.begin(), queue_.end(), std::greater<>{});
-        queue_.pop_back();
-        auto& callback = callbacks_[nextEvent.eventType_];
+        Event nextEvent = heap_[0];
+        RemoveAt(0);
+        auto& callback = callbacks_[static_cast<size_t>(nextEvent.eventType_)];
         callback(totalCycles_ - nextEvent.cycleToExecute_);
-        nextEvent = queue_.front();
     }
 }
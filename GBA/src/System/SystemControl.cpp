@@ -20,8 +20,9 @@ SystemControl::SystemControl(EventScheduler& scheduler) : scheduler_(scheduler)
     interruptAndWaitcntRegisters_.fill(std::byte{0});
     postFlgAndHaltcntRegisters_.fill(std::byte{0});
     memoryControlRegisters_.fill(std::byte{0});
+    UpdateWaitStates();
 
-    scheduler_.RegisterEvent(EventType::SetIRQ, [this](int extraCycles){ this->SetIRQLine(extraCycles); });
+    scheduler_.RegisterEvent(EventType::SetIRQ, {&SystemControl::SetIRQLine, *this});
 }
 
 MemReadData SystemControl::ReadReg(u32 addr, AccessSize length)
@@ -67,6 +68,12 @@ int SystemControl::WriteReg(u32 addr, u32 val, AccessSize length)
     return 1;
 }
 
+MemReadData SystemControl::ReadIEAndIF(u32 addr, AccessSize length)
+{
+    u32 val = ReadMemoryBlockUnchecked(interruptAndWaitcntRegisters_, addr, INT_WAITCNT_ADDR_MIN, length);
+    return {1, val, false};
+}
+
 void SystemControl::RequestInterrupt(InterruptType interrupt)
 {
     u16 IF = GetIF();
@@ -75,58 +82,6 @@ void SystemControl::RequestInterrupt(InterruptType interrupt)
     CheckForInterrupt();
 }
 
-int SystemControl::WaitStates(WaitStateRegion region, bool sequential, AccessSize length) const
-{
-    auto waitcnt = GetWAITCNT();
-    int firstAccess = 0;
-    int secondAccess = 0;
-
-    switch (region)
-    {
-        case WaitStateRegion::ZERO:
-        {
-            firstAccess = sequential ? SequentialWaitStates[0][waitcnt.waitState0SecondAccess] :
-                                       NonSequentialWaitStates[waitcnt.waitState0FirstAccess];
-
-            if (length == AccessSize::WORD)
-            {
-                secondAccess = SequentialWaitStates[0][waitcnt.waitState0SecondAccess];
-            }
-
-            break;
-        }
-        case WaitStateRegion::ONE:
-        {
-            firstAccess = sequential ? SequentialWaitStates[1][waitcnt.waitState1SecondAccess] :
-                                       NonSequentialWaitStates[waitcnt.waitState1FirstAccess];
-
-            if (length == AccessSize::WORD)
-            {
-                secondAccess = SequentialWaitStates[1][waitcnt.waitState1SecondAccess];
-            }
-
-            break;
-        }
-        case WaitStateRegion::TWO:
-        {
-            firstAccess = sequential ? SequentialWaitStates[2][waitcnt.waitState2SecondAccess] :
-                                       NonSequentialWaitStates[waitcnt.waitState2FirstAccess];
-
-            if (length == AccessSize::WORD)
-            {
-                secondAccess = SequentialWaitStates[2][waitcnt.waitState2SecondAccess];
-            }
-
-            break;
-        }
-        case WaitStateRegion::SRAM:
-            firstAccess = NonSequentialWaitStates[waitcnt.sramWaitCtrl];
-            break;
-    }
-
-    return firstAccess + secondAccess;
-}
-
 void SystemControl::Serialize(std::ofstream& saveState) const
 {
     SerializeTrivialType(irqPending_);
@@ -143,6 +98,7 @@ void SystemControl::Deserialize(std::ifstream& saveState)
     DeserializeArray(interruptAndWaitcntRegisters_);
     DeserializeArray(interruptAndWaitcntRegisters_);
     DeserializeArray(memoryControlRegisters_);
+    UpdateWaitStates();
 }
 
 void SystemControl::CheckForInterrupt()
@@ -163,7 +119,7 @@ void SystemControl::CheckForInterrupt()
         irq = false;
     }
 
-    if (!irqPending_ && irq)
+    if (!irqPending_ && irq && !scheduler_.EventScheduled(EventType::SetIRQ))
     {
         scheduler_.ScheduleEvent(EventType::SetIRQ, 3);
     }
@@ -222,6 +178,7 @@ void SystemControl::WriteInterruptAndWaitcntRegisters(u32 addr, u32 val, AccessS
         auto waitcnt = GetWAITCNT();
         waitcnt.gamePakType = 0;
         SetWAITCNT(waitcnt);
+        UpdateWaitStates();
     }
 
     CheckForInterrupt();
@@ -267,3 +224,25 @@ void SystemControl::AcknowledgeInterrupt(u16 ack)
     u16 IF = GetIF() & ~ack;
     SetIF(IF);
 }
+
+void SystemControl::UpdateWaitStates()
+{
+    auto waitcnt = GetWAITCNT();
+    int firstAccess[3] = {waitcnt.waitState0FirstAccess, waitcnt.waitState1FirstAccess, waitcnt.waitState2FirstAccess};
+    int secondAccess[3] = {waitcnt.waitState0SecondAccess, waitcnt.waitState1SecondAccess, waitcnt.waitState2SecondAccess};
+
+    for (size_t region = 0; region < 3; ++region)
+    {
+        u8 nonSequential = NonSequentialWaitStates[firstAccess[region]];
+        u8 sequential = SequentialWaitStates[region][secondAccess[region]];
+
+        // Word accesses are split into two halfword accesses, the second of which is always sequential.
+        waitStates_[region][false] = {nonSequential, static_cast<u8>(nonSequential + sequential)};
+        waitStates_[region][true] = {sequential, static_cast<u8>(sequential + sequential)};
+    }
+
+    u8 sram = NonSequentialWaitStates[waitcnt.sramWaitCtrl];
+    waitStates_[static_cast<size_t>(WaitStateRegion::SRAM)][false] = {sram, sram};
+    waitStates_[static_cast<size_t>(WaitStateRegion::SRAM)][true] = {sram, sram};
+    prefetchEnabled_ = waitcnt.prefetchBuffer;
+}
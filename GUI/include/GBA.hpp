@@ -39,7 +39,7 @@ void RunEmulationLoop();
 void FillAudioBuffer(u8* stream, size_t len);
 
 /// @brief Get a pointer to the most recently completed frame.
-/// @return Pointer to frame buffer data.
+/// @return Pointer to XRGB8888 frame buffer data.
 uchar* GetFrameBuffer();
 
 /// @brief Get FPS counter from PPU.
@@ -102,7 +102,8 @@ void CreateSaveState(std::ofstream& saveState);
 
 /// @brief Load data from save state file.
 /// @param saveState Save state stream to read from.
-void LoadSaveState(std::ifstream& saveState);
+/// @return Whether the save state was loaded. Fails without changing anything if the save state layout is incompatible.
+bool LoadSaveState(std::ifstream& saveState);
 
 ///---------------------------------------------------------------------------------------------------------------------------------
 /// Debug
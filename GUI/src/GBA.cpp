@@ -35,6 +35,8 @@ void InitializeGBA(fs::path biosPath,
 
     GBA = std::make_unique<GameBoyAdvance>(biosPath, romPath, saveDir, vBlankCallback, breakpointCallback, skipBiosIntro);
     GBA->SetCpuClockSpeed(ClockSpeed);
+    GBA->SetFrameSkip(graphics::FrameSkipMode::Auto);
+    GBA->SetPixelFormat(graphics::PixelFormat::XRGB8888);
     GBADebugger = std::make_unique<debug::GameBoyAdvanceDebugger>(*GBA);
 }
 
@@ -85,7 +87,7 @@ void FillAudioBuffer(u8* stream, size_t len)
 
 uchar* GetFrameBuffer()
 {
-    static std::array<u16, 240 * 160> BLANK_SCREEN = {};
+    static std::array<u32, 240 * 160> BLANK_SCREEN = {};
 
     if (!GBA)
     {
@@ -191,12 +193,9 @@ void CreateSaveState(std::ofstream& saveState)
     }
 }
 
-void LoadSaveState(std::ifstream& saveState)
+bool LoadSaveState(std::ifstream& saveState)
 {
-    if (GBA)
-    {
-        GBA->Deserialize(saveState);
-    }
+    return GBA ? GBA->Deserialize(saveState) : false;
 }
 
 ///---------------------------------------------------------------------------------------------------------------------------------
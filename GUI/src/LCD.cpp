@@ -13,8 +13,7 @@ LCD::LCD(QWidget* parent) : QOpenGLWidget(parent)
 void LCD::paintGL()
 {
     QPainter painter(this);
-    auto image = QImage(gba_api::GetFrameBuffer(), 240, 160, QImage::Format_RGB555);
-    image.rgbSwap();
+    auto image = QImage(gba_api::GetFrameBuffer(), 240, 160, QImage::Format_RGB32);
     painter.drawImage(this->rect(), image);
 }
 }  // namespace gui
@@ -732,8 +732,16 @@ void MainWindow::LoadState(u8 index)
     }
 
     StopEmulationThreads();
-    gba_api::LoadSaveState(saveState);
+    bool loaded = gba_api::LoadSaveState(saveState);
     StartEmulationThreads();
+
+    if (!loaded)
+    {
+        QMessageBox::warning(this,
+                             "Save State Error",
+                             "The save state could not be loaded. It was created by an incompatible version of Advanced Boy.",
+                             QMessageBox::Close);
+    }
 }
 
 void MainWindow::PowerDown()